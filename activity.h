@@ -49,6 +49,8 @@ extern int main(int argc, char **argv);
 
 namespace SST {
 
+class Link;
+
 /** Base class for all Activities in the SST Event Queue */
 class Activity : public SST::Core::Serialization::serializable {
 public:
@@ -212,6 +214,20 @@ public:
         return priority;
     }
 
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    /** Return the link order used to break ties between Activities
+     * with the same time and priority */
+    inline int32_t getEnforceLinkOrder() const {
+        return enforce_link_order;
+    }
+#endif
+
+    /** Return the Link this Activity is delivered on, or NULL if it
+     * is not delivered by a Link.  Only Events are. */
+    virtual Link* getDeliveryLink() {
+        return NULL;
+    }
+
     /** Generic print-print function for this Activity.
      * Subclasses should override this function.
      */
@@ -230,31 +246,31 @@ public:
         queue_order = order;
     }
 
+    /** Return the Queue order */
+    inline uint64_t getQueueOrder() const {
+        return queue_order;
+    }
+
 #ifdef USE_MEMPOOL
     /** Allocates memory from a memory pool for a new Activity */
 	void* operator new(std::size_t size) throw()
     {
-        /* 1) Find memory pool
+        /* 1) Find memory pool in this thread's size class table
          * 1.5) If not found, create new
          * 2) Alloc item from pool
          * 3) Append PoolID to item, increment pointer
          */
-        Core::MemPool *pool = NULL;
-        size_t nPools = memPools.size();
-        std::thread::id tid = std::this_thread::get_id();
-        for ( size_t i = 0 ; i < nPools ; i++ ) {
-            PoolInfo_t &p = memPools[i];
-            if ( p.tid == tid && p.size == size ) {
-                pool = p.pool;
-                break;
+        size_t sizeClass = (size + POOL_SIZE_GRANULARITY - 1) / POOL_SIZE_GRANULARITY;
+        Core::MemPool *pool;
+        if ( LIKELY(sizeClass < POOL_SIZE_CLASSES) ) {
+            pool = threadPools[sizeClass];
+            if ( UNLIKELY(NULL == pool) ) {
+                pool = createPool(sizeClass * POOL_SIZE_GRANULARITY);
+                threadPools[sizeClass] = pool;
             }
         }
-        if ( NULL == pool ) {
-            /* Still can't find it, alloc a new one */
-            pool = new Core::MemPool(size+sizeof(PoolData_t));
-
-            std::lock_guard<std::mutex> lock(poolMutex);
-            memPools.emplace_back(tid, size, pool);
+        else {
+            pool = findLargePool(size);
         }
 
         PoolData_t *ptr = (PoolData_t*)pool->malloc();
@@ -297,19 +313,37 @@ public:
     static void getMemPoolUsage(uint64_t& bytes, uint64_t& active_activities) {
         bytes = 0;
         active_activities = 0;
+        // Other threads may be adding pools
+        std::lock_guard<std::mutex> lock(poolMutex);
         for ( auto && entry : Activity::memPools ) {
             bytes += entry.pool->getBytesMemUsed();
             active_activities += entry.pool->getUndeletedEntries();
         }
     }
+
+    /** Get the total number of pool allocations and frees since the
+     * start of the run.  Frees made by a thread other than the
+     * allocating one are included in frees and also reported in
+     * remote_frees. */
+    static void getMemPoolCounters(uint64_t& allocs, uint64_t& frees, uint64_t& remote_frees) {
+        allocs = 0;
+        frees = 0;
+        remote_frees = 0;
+        std::lock_guard<std::mutex> lock(poolMutex);
+        for ( auto && entry : Activity::memPools ) {
+            allocs += entry.pool->numAlloc;
+            remote_frees += entry.pool->numRemoteFree;
+            frees += entry.pool->numFree + entry.pool->numRemoteFree;
+        }
+    }
     
     static void printUndeletedActivites(const std::string& header, Output &out, SimTime_t before = MAX_SIMTIME_T) {
+        std::lock_guard<std::mutex> lock(poolMutex);
         for ( auto && entry : Activity::memPools ) {
             const std::list<uint8_t*>& arenas = entry.pool->getArenas();
-            size_t arenaSize = entry.pool->getArenaSize();
             size_t elemSize = entry.pool->getElementSize();
-            size_t nelem = arenaSize / elemSize;
             for ( auto iter = arenas.begin(); iter != arenas.end(); ++iter ) {
+                size_t nelem = entry.pool->getElementsUsed(*iter);
                 for ( size_t j = 0; j < nelem; j++ ) {
                     PoolData_t* ptr = (PoolData_t*)((*iter) + (elemSize*j));
                     if ( *ptr != NULL ) {
@@ -373,6 +407,31 @@ private:
     };
     static std::mutex poolMutex;
 	static std::vector<PoolInfo_t> memPools;
+
+    /* Per-thread table of pools, indexed by object size rounded up to
+     * POOL_SIZE_GRANULARITY bytes.  Larger objects use the slow path
+     * through memPools. */
+    static const size_t POOL_SIZE_GRANULARITY = 8;
+    static const size_t POOL_SIZE_CLASSES = 128;
+    static thread_local Core::MemPool* threadPools[POOL_SIZE_CLASSES];
+
+    static Core::MemPool* createPool(size_t size) {
+        Core::MemPool* pool = new Core::MemPool(size+sizeof(PoolData_t));
+        std::lock_guard<std::mutex> lock(poolMutex);
+        memPools.emplace_back(std::this_thread::get_id(), size, pool);
+        return pool;
+    }
+
+    static Core::MemPool* findLargePool(size_t size) {
+        std::thread::id tid = std::this_thread::get_id();
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            for ( auto && entry : memPools ) {
+                if ( entry.tid == tid && entry.size == size ) return entry.pool;
+            }
+        }
+        return createPool(size);
+    }
 #endif
 
     friend class boost::serialization::access;
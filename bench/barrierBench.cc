@@ -0,0 +1,131 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// ThreadSafe::Barrier microbenchmark.  Every thread waits at the
+// barrier in a loop, doing a little work of its own in between, and
+// the time per barrier is reported for each mode (spin, hybrid
+// spin-then-sleep, combining tree) over a sweep of thread counts.
+// Every so often one thread does a lot more work than the others, as
+// when one thread of a simulation has a burst of events, which is
+// where the hybrid mode puts the waiting threads to sleep.
+//
+// usage: barrierBench [max_threads [waits [work]]]
+//
+// The thread counts swept are 1, 2, 4, ... up to max_threads (default:
+// the number of cores).  work is the number of loop iterations each
+// thread does between waits (default 100); one wait in 64 one thread
+// does 100x that.  Above the number of cores, the spinning modes
+// mostly measure how long a descheduled thread takes to run again.
+
+#include "sst_config.h"
+
+#include <sst/core/threadsafe.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SST::Core::ThreadSafe;
+
+namespace {
+
+volatile uint64_t sink;
+
+void
+doWork(uint64_t iterations)
+{
+    uint64_t value = 0;
+    for ( uint64_t i = 0; i < iterations; i++ ) {
+        value = value * 31 + i;
+    }
+    sink = value;
+}
+
+struct Mode {
+    const char* name;
+    bool hybrid;
+    bool tree;
+};
+
+const Mode modes[] = {
+    { "spin", false, false },
+    { "hybrid", true, false },
+    { "tree", false, true },
+    { "tree+hybrid", true, true },
+};
+
+// Returns the wall time per wait in nanoseconds
+double
+runBarrier(const Mode& mode, uint32_t num_threads, uint64_t waits, uint64_t work)
+{
+    Barrier barrier(num_threads);
+    barrier.setHybrid(mode.hybrid);
+    barrier.setTree(mode.tree);
+
+    auto body = [&](uint32_t index) {
+        Barrier::setThreadIndex(index);
+        for ( uint64_t i = 0; i < waits; i++ ) {
+            // Rotate the slow thread so no thread is always last
+            bool slow = (i & 63) == 0 && (i >> 6) % num_threads == index;
+            doWork(slow ? 100 * work : work);
+            barrier.wait();
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for ( uint32_t t = 1; t < num_threads; t++ ) {
+        threads.push_back(std::thread(body, t));
+    }
+    body(0);
+    for ( size_t t = 0; t < threads.size(); t++ ) {
+        threads[t].join();
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return secs * 1e9 / waits;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t max_threads = argc > 1 ? strtoul(argv[1], NULL, 0) : std::thread::hardware_concurrency();
+    uint64_t waits = argc > 2 ? (uint64_t)strtod(argv[2], NULL) : 100000;
+    uint64_t work = argc > 3 ? (uint64_t)strtod(argv[3], NULL) : 100;
+    if ( max_threads < 1 ) max_threads = 1;
+
+    printf("%-8s", "threads");
+    for ( size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++ ) {
+        printf(" %14s", (std::string(modes[m].name) + " ns").c_str());
+    }
+    printf("\n");
+
+    std::vector<uint32_t> counts;
+    for ( uint32_t n = 1; n < max_threads; n *= 2 ) {
+        counts.push_back(n);
+    }
+    counts.push_back(max_threads);
+
+    for ( size_t c = 0; c < counts.size(); c++ ) {
+        printf("%-8u", counts[c]);
+        for ( size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++ ) {
+            printf(" %14.1f", runBarrier(modes[m], counts[c], waits, work));
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+    return 0;
+}
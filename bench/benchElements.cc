@@ -0,0 +1,433 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Element library used by the simulation level benchmarks.  It holds
+// a node that passes tokens to its neighbors, clocked components for
+// the clock dispatch benchmark, and generators that wire them into
+// rings, 2D meshes and flat clock models without needing Python.
+//
+// Each rank prints one line when its last component finishes:
+//
+//   bench: rank R: C components, L links, E events in S s (X events/s)
+//
+// Load it with --lib-path=<build>/bench/.libs and run the models with
+// --generator bench.<name> --gen-options "key=value ...".  The
+// components never end the simulation on their own, so give --stop-at.
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/component.h>
+#include <sst/core/configGraph.h>
+#include <sst/core/element.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/params.h>
+#include <sst/core/simulation.h>
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace SST;
+
+namespace SST {
+namespace Bench {
+
+class BenchEvent : public Event, public SST::Core::Serialization::serializable_type<BenchEvent> {
+public:
+    BenchEvent() : hops(0) {} // For serialization only
+
+    BenchEvent(uint64_t hops) : Event(), hops(hops) {}
+
+    uint64_t hops;
+
+    void serialize_order(SST::Core::Serialization::serializer &ser) {
+        Event::serialize_order(ser);
+        ser & hops;
+    }
+
+    ImplementSerializable(SST::Bench::BenchEvent);
+};
+
+// Counts shared by all the components of a rank.  The last one to
+// finish prints them.
+struct RankCounts {
+    std::atomic<uint64_t> components;
+    std::atomic<uint64_t> links;
+    std::atomic<uint64_t> events;
+    std::atomic<uint64_t> live;
+    std::once_flag started;
+    std::chrono::steady_clock::time_point start;
+
+    RankCounts() : components(0), links(0), events(0), live(0) {}
+
+    void begin() {
+        std::call_once(started, [this]() { start = std::chrono::steady_clock::now(); });
+    }
+
+    void end(uint64_t num_links, uint64_t num_events) {
+        components++;
+        links += num_links;
+        events += num_events;
+        if ( --live != 0 ) return;
+
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("bench: rank %u: %" PRIu64 " components, %" PRIu64 " links, %" PRIu64 " events in %.3f s (%.0f events/s)\n",
+               Simulation::getSimulation()->getRank().rank, components.load(), links.load(),
+               events.load(), secs, secs > 0 ? events.load() / secs : 0.0);
+        fflush(stdout);
+    }
+};
+
+static RankCounts counts;
+
+// Passes tokens on to its neighbors.  Each node starts with "tokens"
+// tokens and sends every token it receives out of a pseudo-random
+// connected port, after "work" iterations of busy work.
+class Node : public Component {
+public:
+    Node(ComponentId_t id, Params& params) :
+        Component(id),
+        events(0),
+        sink(0)
+    {
+        int num_ports = params.find<int>("ports", 4);
+        tokens = params.find<int>("tokens", 1);
+        work = params.find<int>("work", 0);
+        rng = 0x9e3779b97f4a7c15ull * (id + 1);
+
+        // Tokens go out with no delay beyond the link latency
+        registerTimeBase("1ns", true);
+        for ( int i = 0; i < num_ports; i++ ) {
+            std::ostringstream port;
+            port << "port" << i;
+            Link* link = configureLink(port.str(), new Event::Handler<Node>(this, &Node::handleEvent));
+            if ( link != NULL ) links.push_back(link);
+        }
+        // Run until --stop-at
+        registerAsPrimaryComponent();
+        primaryComponentDoNotEndSim();
+        counts.live++;
+    }
+
+    void setup() {
+        counts.begin();
+        if ( links.empty() ) return;
+        for ( int i = 0; i < tokens; i++ ) {
+            nextLink()->send(new BenchEvent(0));
+        }
+    }
+
+    void finish() {
+        counts.end(links.size(), events);
+    }
+
+private:
+    void handleEvent(Event* ev) {
+        BenchEvent* token = static_cast<BenchEvent*>(ev);
+        events++;
+        for ( int i = 0; i < work; i++ ) {
+            sink = sink * 31 + i;
+        }
+        token->hops++;
+        nextLink()->send(token);
+    }
+
+    Link* nextLink() {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return links[rng % links.size()];
+    }
+
+    std::vector<Link*> links;
+    int tokens;
+    int work;
+    uint64_t rng;
+    uint64_t events;
+    volatile uint64_t sink;
+};
+
+// Does a little work on every tick of a shared clock.  One class per
+// kind, so each kind has its own clock handler type.
+template <int kind>
+class ClockNode : public Component {
+public:
+    ClockNode(ComponentId_t id, Params& params) :
+        Component(id),
+        ticks(0),
+        sink(kind)
+    {
+        work = params.find<int>("work", 0);
+        registerClock(params.find<std::string>("clock", "1GHz"),
+                      new Clock::Handler<ClockNode>(this, &ClockNode::tick));
+        // Run until --stop-at
+        registerAsPrimaryComponent();
+        primaryComponentDoNotEndSim();
+        counts.live++;
+    }
+
+    void setup() {
+        counts.begin();
+    }
+
+    void finish() {
+        counts.end(0, ticks);
+    }
+
+private:
+    bool tick(Cycle_t cycle) {
+        ticks++;
+        uint64_t value = sink;
+        for ( int i = 0; i < work; i++ ) {
+            value = value * (kind + 3) + cycle;
+        }
+        sink = value + kind;
+        return false;
+    }
+
+    int work;
+    uint64_t ticks;
+    volatile uint64_t sink;
+};
+
+
+// Generator options are "key=value" pairs separated by spaces
+typedef std::map<std::string, std::string> options_t;
+
+static options_t
+parseOptions(const std::string& str, const options_t& defaults)
+{
+    options_t opts = defaults;
+    std::istringstream in(str);
+    std::string token;
+    while ( in >> token ) {
+        size_t eq = token.find('=');
+        std::string key = token.substr(0, eq);
+        if ( eq == std::string::npos || opts.find(key) == opts.end() ) {
+            fprintf(stderr, "bench: unknown generator option '%s'\n", token.c_str());
+            exit(1);
+        }
+        opts[key] = token.substr(eq + 1);
+    }
+    return opts;
+}
+
+static long
+intOption(options_t& opts, const char* key)
+{
+    return strtol(opts[key].c_str(), NULL, 0);
+}
+
+// Adds a bench.node.  By default the partitioner places the nodes
+// (place=auto).  place=block gives each of the ranks x threads slots a
+// block of consecutive nodes, and place=cyclic deals the nodes out to
+// the slots in turn, so every link crosses slots; run those with
+// --partitioner self.
+static ComponentId_t
+addNode(ConfigGraph* graph, options_t& opts, long index, long total, int ranks, int num_ports)
+{
+    std::ostringstream name;
+    name << "node" << index;
+    ComponentId_t id = graph->addComponent(name.str(), "bench.node");
+    long threads = intOption(opts, "threads");
+    long slots = ranks * threads;
+    if ( opts["place"] == "block" ) {
+        long slot = index * slots / total;
+        graph->setComponentRank(id, RankInfo(slot / threads, slot % threads));
+    }
+    else if ( opts["place"] == "cyclic" ) {
+        long slot = index % slots;
+        graph->setComponentRank(id, RankInfo(slot / threads, slot % threads));
+    }
+    else if ( opts["place"] != "auto" ) {
+        fprintf(stderr, "bench: place must be auto, block or cyclic\n");
+        exit(1);
+    }
+    std::ostringstream ports;
+    ports << num_ports;
+    graph->addParameter(id, "ports", ports.str());
+    graph->addParameter(id, "tokens", opts["tokens"]);
+    graph->addParameter(id, "work", opts["work"]);
+    return id;
+}
+
+static void
+addLink(ConfigGraph* graph, ComponentId_t a, int port_a, ComponentId_t b, int port_b, const std::string& latency)
+{
+    std::ostringstream name, pa, pb;
+    name << "link" << a << "_" << port_a;
+    pa << "port" << port_a;
+    pb << "port" << port_b;
+    graph->addLink(a, name.str(), pa.str(), latency);
+    graph->addLink(b, name.str(), pb.str(), latency);
+}
+
+static void
+node_defaults(options_t& defaults)
+{
+    defaults["latency"] = "1ns";
+    defaults["tokens"] = "1";
+    defaults["work"] = "0";
+    defaults["place"] = "auto";
+    defaults["threads"] = "1";
+}
+
+// size nodes in a ring.  If short is set, the link that closes the
+// ring gets that latency instead.
+static void
+generateRing(ConfigGraph* graph, std::string options, int ranks)
+{
+    options_t defaults;
+    node_defaults(defaults);
+    defaults["size"] = "64";
+    defaults["short"] = "";
+    options_t opts = parseOptions(options, defaults);
+
+    long size = intOption(opts, "size");
+    std::vector<ComponentId_t> ids;
+    for ( long i = 0; i < size; i++ ) {
+        ids.push_back(addNode(graph, opts, i, size, ranks, 2));
+    }
+    for ( long i = 0; i < size; i++ ) {
+        bool closing = i == size - 1;
+        const std::string& latency = closing && opts["short"] != "" ? opts["short"] : opts["latency"];
+        addLink(graph, ids[i], 1, ids[(i + 1) % size], 0, latency);
+    }
+}
+
+// An x by y mesh without wrap around, numbered by rows
+static void
+generateMesh(ConfigGraph* graph, std::string options, int ranks)
+{
+    options_t defaults;
+    node_defaults(defaults);
+    defaults["x"] = "8";
+    defaults["y"] = "8";
+    options_t opts = parseOptions(options, defaults);
+
+    long x = intOption(opts, "x");
+    long y = intOption(opts, "y");
+    std::vector<ComponentId_t> ids;
+    for ( long i = 0; i < x * y; i++ ) {
+        ids.push_back(addNode(graph, opts, i, x * y, ranks, 4));
+    }
+    // Ports: 0 east, 1 west, 2 north, 3 south
+    for ( long j = 0; j < y; j++ ) {
+        for ( long i = 0; i < x; i++ ) {
+            if ( i + 1 < x ) addLink(graph, ids[j * x + i], 0, ids[j * x + i + 1], 1, opts["latency"]);
+            if ( j + 1 < y ) addLink(graph, ids[j * x + i], 3, ids[(j + 1) * x + i], 2, opts["latency"]);
+        }
+    }
+}
+
+// size clocked components on one clock.  The kinds are interleaved,
+// which is the worst order for dispatching their handlers.
+static void
+generateClocks(ConfigGraph* graph, std::string options, int ranks)
+{
+    options_t defaults;
+    defaults["size"] = "1024";
+    defaults["kinds"] = "4";
+    defaults["clock"] = "1GHz";
+    defaults["work"] = "0";
+    options_t opts = parseOptions(options, defaults);
+
+    long size = intOption(opts, "size");
+    long kinds = intOption(opts, "kinds");
+    if ( kinds < 1 || kinds > 4 ) {
+        fprintf(stderr, "bench: kinds must be 1 to 4\n");
+        exit(1);
+    }
+    for ( long i = 0; i < size; i++ ) {
+        std::ostringstream name, type;
+        name << "clock" << i;
+        type << "bench.clock" << i % kinds;
+        ComponentId_t id = graph->addComponent(name.str(), type.str());
+        graph->addParameter(id, "clock", opts["clock"]);
+        graph->addParameter(id, "work", opts["work"]);
+    }
+}
+
+static Component*
+create_node(ComponentId_t id, Params& params)
+{
+    return new Node(id, params);
+}
+
+template <int kind>
+static Component*
+create_clock(ComponentId_t id, Params& params)
+{
+    return new ClockNode<kind>(id, params);
+}
+
+static const ElementInfoParam node_params[] = {
+    { "ports", "Number of ports to look for", "4" },
+    { "tokens", "Tokens the node sends at setup", "1" },
+    { "work", "Busy loop iterations per token received", "0" },
+    { NULL, NULL, NULL }
+};
+
+static const char* node_events[] = { "bench.BenchEvent", NULL };
+
+static const ElementInfoPort node_ports[] = {
+    { "port%(ports)d", "Link to a neighbor", node_events },
+    { NULL, NULL, NULL }
+};
+
+static const ElementInfoParam clock_params[] = {
+    { "clock", "Clock frequency", "1GHz" },
+    { "work", "Busy loop iterations per tick", "0" },
+    { NULL, NULL, NULL }
+};
+
+static const ElementInfoComponent components[] = {
+    { "node", "Passes tokens to its neighbors", NULL, create_node, node_params, node_ports, COMPONENT_CATEGORY_UNCATEGORIZED, NULL },
+    { "clock0", "Clocked component, kind 0", NULL, create_clock<0>, clock_params, NULL, COMPONENT_CATEGORY_UNCATEGORIZED, NULL },
+    { "clock1", "Clocked component, kind 1", NULL, create_clock<1>, clock_params, NULL, COMPONENT_CATEGORY_UNCATEGORIZED, NULL },
+    { "clock2", "Clocked component, kind 2", NULL, create_clock<2>, clock_params, NULL, COMPONENT_CATEGORY_UNCATEGORIZED, NULL },
+    { "clock3", "Clocked component, kind 3", NULL, create_clock<3>, clock_params, NULL, COMPONENT_CATEGORY_UNCATEGORIZED, NULL },
+    { NULL, NULL, NULL, NULL, NULL, NULL, 0, NULL }
+};
+
+static const ElementInfoGenerator generators[] = {
+    { "ring", "Ring of nodes: size= latency= short= tokens= work= place= threads=", NULL, generateRing },
+    { "mesh", "2D mesh of nodes: x= y= latency= tokens= work= place= threads=", NULL, generateMesh },
+    { "clocks", "Clocked components: size= kinds= clock= work=", NULL, generateClocks },
+    { NULL, NULL, NULL, NULL }
+};
+
+} // namespace Bench
+} // namespace SST
+
+extern "C" {
+    ElementLibraryInfo bench_eli = {
+        "bench",
+        "Components and generators for the core benchmarks",
+        SST::Bench::components,
+        NULL,   // Events
+        NULL,   // Introspectors
+        NULL,   // Modules
+        NULL,   // Subcomponents
+        NULL,   // Partitioners
+        NULL,   // Python Module Generator
+        SST::Bench::generators,
+    };
+}
@@ -0,0 +1,40 @@
+#!/bin/sh
+#
+# Clock dispatch benchmark.  Runs the bench element library's clocks
+# model: N components on one shared clock, of up to four component
+# types registered in turn, each doing a little work per tick.  Every
+# model runs T ticks, once with the handlers in the order they were
+# registered and once with --group-clock-handlers, and the time per
+# handler call is printed for each.
+#
+# usage: bench/clockBench.sh [ticks [handlers ...]]
+#
+# Run it from the build directory after "make sstsim.x benchmarks", or
+# point SSTSIM and BENCH_LIB at the binary and the library directory.
+# WORK is the work each handler does per tick (0) and extra sstsim.x
+# options can be passed in SST_OPTIONS.
+
+SSTSIM=${SSTSIM:-./sstsim.x}
+BENCH_LIB=${BENCH_LIB:-bench/.libs}
+WORK=${WORK:-0}
+
+ticks=${1:-1000}
+if [ $# -gt 1 ]; then shift; sizes="$*"; else sizes="1000 10000 100000"; fi
+
+run() {
+    # prints ns per handler call, or "-" if the run failed.  The clock
+    # is 1GHz, so T ticks take T ns.
+    $SSTSIM --lib-path=$BENCH_LIB $SST_OPTIONS --stop-at ${ticks}ns "$@" 2>&1 |
+        awk '/^bench: / { n++; ev += $8; if ( $11 > t ) t = $11 }
+             END { if ( n > 0 && ev > 0 ) printf "%.1f\n", t * 1e9 / ev; else print "-" }'
+}
+
+printf "%10s %6s %8s %14s %14s\n" "handlers" "types" "ticks" "ordered ns" "grouped ns"
+for size in $sizes; do
+    for kinds in 1 4; do
+        opts="size=$size kinds=$kinds work=$WORK"
+        ordered=$(run --generator bench.clocks --gen-options "$opts")
+        grouped=$(run --group-clock-handlers --generator bench.clocks --gen-options "$opts")
+        printf "%10s %6s %8s %14s %14s\n" "$size" "$kinds" "$ticks" "$ordered" "$grouped"
+    done
+done
@@ -0,0 +1,53 @@
+#!/bin/sh
+#
+# Parallel load check.  Runs the bench element library's ring and 2D
+# mesh models on several MPI rank counts, once loaded normally and once
+# with --parallel-load, with the linear partitioner and with ranks
+# given by the model (--partitioner self), and checks that every rank
+# ends up with the same number of components, links and events both
+# ways.  Prints one line per run and exits non-zero on a mismatch.
+#
+# usage: bench/parallelLoadCheck.sh [ranks ...]
+#
+# Run it from the build directory after "make sstsim.x benchmarks", or
+# point SSTSIM and BENCH_LIB at the binary and the library directory.
+# MPIRUN is the launcher ("mpirun -np" by default).
+
+SSTSIM=${SSTSIM:-./sstsim.x}
+BENCH_LIB=${BENCH_LIB:-bench/.libs}
+MPIRUN=${MPIRUN:-"mpirun -np"}
+
+if [ $# -gt 0 ]; then ranks="$*"; else ranks="2 3 4"; fi
+
+counts() {
+    # "rank: components links events" for each rank, in rank order
+    n=$1; shift
+    $MPIRUN $n $SSTSIM --lib-path=$BENCH_LIB --stop-at 50ns "$@" 2>&1 |
+        awk '/^bench: / { print $3, $4, $6, $8 }' | sort -n
+}
+
+status=0
+for model in "ring size=250" "mesh x=13 y=7"; do
+    gen=bench.${model%% *}
+    for part in "linear place=auto" "self place=block" "self place=cyclic"; do
+        opts="${model#* } ${part#* }"
+        for n in $ranks; do
+            normal=$(counts $n --partitioner ${part%% *} --generator $gen --gen-options "$opts")
+            parallel=$(counts $n --parallel-load --partitioner ${part%% *} --generator $gen --gen-options "$opts")
+            lines=$(echo "$normal" | grep -c .)
+            if [ "$lines" -eq "$n" ] && [ "$normal" = "$parallel" ]; then
+                result=ok
+            else
+                result=MISMATCH
+                status=1
+            fi
+            printf "%-6s %-26s %-20s ranks %2s  %s\n" "$result" "$gen $opts" "--partitioner ${part%% *}" "$n" \
+                "$(echo "$normal" | awk '{ printf "%s%s/%s/%s", sep, $2, $3, $4; sep = " " }')"
+            if [ "$result" != ok ]; then
+                echo "  normal:   " $normal
+                echo "  parallel: " $parallel
+            fi
+        done
+    done
+done
+exit $status
@@ -0,0 +1,206 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Partitioner benchmark.  Builds the PartitionGraph of a 3D torus and
+// splits it over ranks x threads with a linear split in component
+// order (as the linear partitioner does), the multilevel partitioner
+// and the hierarchical partitioner.  For each it prints the time taken,
+// the links cut between ranks and between the threads of a rank with
+// the lowest latency of each (the two lookaheads), and the imbalance
+// (heaviest part over the average).
+//
+// Links along z have a tenth of the latency of those along x and y, as
+// in a machine whose nodes are much closer together in one direction,
+// so a partition that cuts a z link lowers the lookahead tenfold.
+//
+// usage: partitionBench [x [y [z [ranks [threads [partitioner ...]]]]]]
+//
+// The default is a 100x100x100 torus (1M components) on 16 ranks of 4
+// threads.  A 216x216x216 torus is about 10M components and needs
+// around 8GB.
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/configGraph.h>
+#include <sst/core/part/mlpart.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace SST;
+
+namespace {
+
+const SimTime_t LATENCY = 1000;
+const SimTime_t SHORT_LATENCY = 100;
+
+PartitionGraph*
+buildTorus(uint32_t x, uint32_t y, uint32_t z)
+{
+    PartitionGraph* graph = new PartitionGraph();
+    PartitionComponentMap_t& comps = graph->getComponentMap();
+    PartitionLinkMap_t& links = graph->getLinkMap();
+
+    // Inserted in id order, as SparseVectorMap wants.  The partitioners
+    // only look at the link map, so the components' link lists are
+    // left empty to save memory.
+    uint64_t n = (uint64_t)x * y * z;
+    for ( ComponentId_t id = 0; id < n; id++ ) {
+        comps.insert(PartitionComponent((LinkId_t)id));
+        comps[id].weight = 1.0f;
+        comps[id].group.insert(id);
+    }
+
+    ConfigLink link;
+    link.no_cut = false;
+    link.event_count = 0;
+    link.id = 0;
+    for ( uint32_t k = 0; k < z; k++ ) {
+        for ( uint32_t j = 0; j < y; j++ ) {
+            for ( uint32_t i = 0; i < x; i++ ) {
+                ComponentId_t id = ((uint64_t)k * y + j) * x + i;
+                ComponentId_t next[3] = {
+                    ((uint64_t)k * y + j) * x + (i + 1) % x,
+                    ((uint64_t)k * y + (j + 1) % y) * x + i,
+                    ((uint64_t)((k + 1) % z) * y + j) * x + i
+                };
+                for ( int d = 0; d < 3; d++ ) {
+                    // A dimension of 1 or 2 would link a component to
+                    // itself or twice to the same neighbor
+                    if ( next[d] == id || (d == 0 && x == 2 && i == 1) ||
+                         (d == 1 && y == 2 && j == 1) || (d == 2 && z == 2 && k == 1) ) continue;
+                    link.component[0] = id;
+                    link.component[1] = next[d];
+                    link.latency[0] = link.latency[1] = d == 2 ? SHORT_LATENCY : LATENCY;
+                    links.insert(PartitionLink(link));
+                    link.id++;
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+double
+seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void
+report(const char* name, double secs, PartitionGraph* graph, RankInfo ranks)
+{
+    PartitionComponentMap_t& comps = graph->getComponentMap();
+    PartitionLinkMap_t& links = graph->getLinkMap();
+
+    uint64_t rank_cuts = 0;
+    uint64_t thread_cuts = 0;
+    SimTime_t rank_latency = MAX_SIMTIME_T;
+    SimTime_t thread_latency = MAX_SIMTIME_T;
+    for ( PartitionLinkMap_t::iterator it = links.begin(); it != links.end(); ++it ) {
+        const RankInfo& r0 = comps[it->component[0]].rank;
+        const RankInfo& r1 = comps[it->component[1]].rank;
+        if ( r0.rank != r1.rank ) {
+            rank_cuts++;
+            rank_latency = std::min(rank_latency, it->getMinLatency());
+        }
+        else if ( r0.thread != r1.thread ) {
+            thread_cuts++;
+            thread_latency = std::min(thread_latency, it->getMinLatency());
+        }
+    }
+
+    std::vector<double> weight(ranks.rank * ranks.thread, 0.0);
+    for ( PartitionComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
+        weight[it->rank.rank * ranks.thread + it->rank.thread] += it->weight;
+    }
+    double total = 0.0;
+    double heaviest = 0.0;
+    for ( size_t i = 0; i < weight.size(); i++ ) {
+        total += weight[i];
+        heaviest = std::max(heaviest, weight[i]);
+    }
+
+    printf("%-13s %9.2f %12" PRIu64 " %8s %12" PRIu64 " %8s %9.3f\n", name, secs,
+           rank_cuts, rank_cuts ? std::to_string(rank_latency).c_str() : "-",
+           thread_cuts, thread_cuts ? std::to_string(thread_latency).c_str() : "-",
+           heaviest * weight.size() / total);
+}
+
+// Blocks of consecutive component ids, as SSTLinearPartition assigns
+// them
+void
+linearSplit(PartitionGraph* graph, RankInfo ranks)
+{
+    PartitionComponentMap_t& comps = graph->getComponentMap();
+    uint64_t n = comps.size();
+    uint64_t parts = ranks.rank * ranks.thread;
+    uint64_t v = 0;
+    for ( PartitionComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it, ++v ) {
+        uint64_t part = v * parts / n;
+        it->rank = RankInfo(part / ranks.thread, part % ranks.thread);
+    }
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t x = argc > 1 ? strtoul(argv[1], NULL, 0) : 100;
+    uint32_t y = argc > 2 ? strtoul(argv[2], NULL, 0) : 100;
+    uint32_t z = argc > 3 ? strtoul(argv[3], NULL, 0) : 100;
+    RankInfo ranks(argc > 4 ? strtoul(argv[4], NULL, 0) : 16, argc > 5 ? strtoul(argv[5], NULL, 0) : 4);
+    std::vector<std::string> names;
+    for ( int i = 6; i < argc; i++ ) names.push_back(argv[i]);
+    if ( names.empty() ) {
+        names.push_back("linear");
+        names.push_back("multilevel");
+        names.push_back("hierarchical");
+    }
+    if ( x == 0 || y == 0 || z == 0 || ranks.rank == 0 || ranks.thread == 0 ) {
+        fprintf(stderr, "usage: %s [x [y [z [ranks [threads [partitioner ...]]]]]]\n", argv[0]);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    PartitionGraph* graph = buildTorus(x, y, z);
+    printf("%ux%ux%u torus: %zu components, %zu links, built in %.2f s; %u ranks x %u threads\n",
+           x, y, z, graph->getNumComponents(), (size_t)graph->getLinkMap().size(), seconds(start),
+           ranks.rank, ranks.thread);
+    printf("%-13s %9s %12s %8s %12s %8s %9s\n", "partitioner", "seconds",
+           "rank cuts", "latency", "thread cuts", "latency", "imbalance");
+
+    for ( size_t i = 0; i < names.size(); i++ ) {
+        start = std::chrono::steady_clock::now();
+        if ( names[i] == "linear" ) {
+            linearSplit(graph, ranks);
+        }
+        else if ( names[i] == "multilevel" || names[i] == "hierarchical" ) {
+            Partition::SSTMultilevelPartition partitioner(ranks, 0, names[i] == "hierarchical");
+            partitioner.performPartition(graph);
+        }
+        else {
+            fprintf(stderr, "Unknown partitioner: %s\n", names[i].c_str());
+            return 1;
+        }
+        report(names[i].c_str(), seconds(start), graph, ranks);
+    }
+
+    delete graph;
+    return 0;
+}
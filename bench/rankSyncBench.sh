@@ -0,0 +1,49 @@
+#!/bin/sh
+#
+# Rank sync benchmark.  Runs the bench element library's ring and 2D
+# mesh models on a sweep of MPI rank counts with the default
+# RankSyncSerialSkip, with --async-rank-sync, and with
+# --null-message-sync (RankSyncNullMessage), and prints the events per
+# second of each: the events of all ranks over the time of the slowest.
+#
+# The "ring+short" model gives one link of the ring a tenth of the
+# latency of the others.  The skip syncs then run every rank at that
+# lookahead, while the null message sync only holds back the two
+# ranks at the ends of the short link.
+#
+# usage: bench/rankSyncBench.sh [stop_at [ranks ...]]
+#
+# Run it from the build directory after "make sstsim.x benchmarks", or
+# point SSTSIM and BENCH_LIB at the binary and the library directory.
+# MPIRUN is the launcher ("mpirun -np" by default) and extra sstsim.x
+# options can be passed in SST_OPTIONS.  Run with -v in SST_OPTIONS to
+# also get the message and wait counters of each sync.
+
+SSTSIM=${SSTSIM:-./sstsim.x}
+BENCH_LIB=${BENCH_LIB:-bench/.libs}
+MPIRUN=${MPIRUN:-"mpirun -np"}
+
+stop_at=${1:-100us}
+if [ $# -gt 1 ]; then shift; ranks="$*"; else ranks="2 4 8"; fi
+
+run() {
+    # prints total events/s, or "-" if the run failed
+    n=$1; shift
+    $MPIRUN $n $SSTSIM --lib-path=$BENCH_LIB $SST_OPTIONS --stop-at $stop_at "$@" 2>&1 |
+        awk '/^bench: / { n++; ev += $8; if ( $11 > t ) t = $11 }
+             END { if ( n == '$n' && t > 0 ) printf "%.0f\n", ev / t; else print "-" }'
+}
+
+printf "%-12s %6s %14s %14s %14s\n" "model" "ranks" "skip ev/s" "async ev/s" "null ev/s"
+for model in "ring size=256" "ring size=256 short=100ps" "mesh x=16 y=16"; do
+    name=${model%% *}
+    case "$model" in *short=*) name="$name+short" ;; esac
+    gen=bench.${model%% *}
+    opts="${model#* }"
+    for n in $ranks; do
+        skip=$(run $n --generator $gen --gen-options "$opts")
+        async=$(run $n --async-rank-sync --generator $gen --gen-options "$opts")
+        null=$(run $n --null-message-sync --generator $gen --gen-options "$opts")
+        printf "%-12s %6s %14s %14s %14s\n" "$name" "$n" "$skip" "$async" "$null"
+    done
+done
@@ -0,0 +1,49 @@
+#!/bin/sh
+#
+# Sync delivery benchmark.  Runs rings of the bench element library's
+# nodes with the nodes dealt out to the threads or ranks in turn, so
+# every link crosses a sync and every event is delivered by one.  The
+# number of nodes sets the number of links each sync has to look up
+# the receiving link among.  Prints the events per second of each run:
+# the events of all ranks over the time of the slowest.
+#
+# usage: bench/syncDeliveryBench.sh [stop_at [sizes ...]]
+#
+# Run it from the build directory after "make sstsim.x benchmarks", or
+# point SSTSIM and BENCH_LIB at the binary and the library directory.
+# PARALLEL is the number of threads and of ranks to run on (2), MPIRUN
+# the launcher ("mpirun -np" by default), and extra sstsim.x options
+# can be passed in SST_OPTIONS.  MODES picks the syncs to run ("threads
+# ranks" by default).  To compare two builds, run the script against
+# each.
+
+SSTSIM=${SSTSIM:-./sstsim.x}
+BENCH_LIB=${BENCH_LIB:-bench/.libs}
+MPIRUN=${MPIRUN:-"mpirun -np"}
+PARALLEL=${PARALLEL:-2}
+MODES=${MODES:-"threads ranks"}
+
+stop_at=${1:-20us}
+if [ $# -gt 1 ]; then shift; sizes="$*"; else sizes="256 4096 65536"; fi
+
+events_per_sec() {
+    awk '/^bench: / { n++; ev += $8; if ( $11 > t ) t = $11 }
+         END { if ( n > 0 && t > 0 ) printf "%.0f\n", ev / t; else print "-" }'
+}
+
+printf "%8s %16s %16s\n" "nodes" "thread sync ev/s" "rank sync ev/s"
+for size in $sizes; do
+    threads=-
+    ranks=-
+    case "$MODES" in *threads*)
+        threads=$($SSTSIM --lib-path=$BENCH_LIB $SST_OPTIONS --stop-at $stop_at -n $PARALLEL \
+            --partitioner self --generator bench.ring \
+            --gen-options "size=$size tokens=4 place=cyclic threads=$PARALLEL" 2>&1 | events_per_sec) ;;
+    esac
+    case "$MODES" in *ranks*)
+        ranks=$($MPIRUN $PARALLEL $SSTSIM --lib-path=$BENCH_LIB $SST_OPTIONS --stop-at $stop_at \
+            --partitioner self --generator bench.ring \
+            --gen-options "size=$size tokens=4 place=cyclic" 2>&1 | events_per_sec) ;;
+    esac
+    printf "%8s %16s %16s\n" "$size" "$threads" "$ranks"
+done
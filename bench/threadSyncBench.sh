@@ -0,0 +1,42 @@
+#!/bin/sh
+#
+# Thread sync benchmark.  Runs the bench element library's ring and 2D
+# mesh models on a sweep of thread counts, once with the default
+# ThreadSyncSimpleSkip and once with --pairwise-thread-sync
+# (ThreadSyncPairwiseSkip), and prints the events per second of each.
+#
+# The "ring+short" model gives one link of the ring a tenth of the
+# latency of the others, so one pair of threads has to sync far more
+# often than the rest.
+#
+# usage: bench/threadSyncBench.sh [stop_at [threads ...]]
+#
+# Run it from the build directory after "make sstsim.x benchmarks", or
+# point SSTSIM and BENCH_LIB at the binary and the library directory.
+# Extra sstsim.x options can be passed in SST_OPTIONS.  Thread counts
+# above the number of cores only check that the syncs work.
+
+SSTSIM=${SSTSIM:-./sstsim.x}
+BENCH_LIB=${BENCH_LIB:-bench/.libs}
+
+stop_at=${1:-100us}
+if [ $# -gt 1 ]; then shift; threads="$*"; else threads="1 2 4 8"; fi
+
+run() {
+    # prints events/s, or "-" if the run failed
+    $SSTSIM --lib-path=$BENCH_LIB $SST_OPTIONS --stop-at $stop_at "$@" 2>&1 |
+        sed -n 's/^bench: .*(\([0-9]*\) events\/s)$/\1/p' | grep . || echo "-"
+}
+
+printf "%-12s %8s %14s %14s\n" "model" "threads" "simple ev/s" "pairwise ev/s"
+for model in "ring size=256" "ring size=256 short=100ps" "mesh x=16 y=16"; do
+    name=${model%% *}
+    case "$model" in *short=*) name="$name+short" ;; esac
+    gen=bench.$name
+    gen=${gen%+short}
+    for n in $threads; do
+        simple=$(run -n $n --generator $gen --gen-options "${model#* }")
+        pairwise=$(run -n $n --pairwise-thread-sync --generator $gen --gen-options "${model#* }")
+        printf "%-12s %8s %14s %14s\n" "$name" "$n" "$simple" "$pairwise"
+    done
+done
@@ -0,0 +1,173 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// TimeVortex microbenchmark.  Runs the classic hold model on each queue
+// engine: the queue is filled with N pending activities, then every
+// operation pops the earliest one and puts it back a random delay later,
+// so the number of pending activities stays at N.  The hold is then
+// repeated popping whole batches of activities with the same time and
+// priority.
+//
+// usage: timeVortexBench [max_pending [ops [engine ...]]]
+//
+// The populations swept are 1e3, 1e4, ... up to max_pending (default
+// 1e6, pass 1e8 for the full sweep; that needs ~10GB).
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/action.h>
+#include <sst/core/timeVortex.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SST;
+
+namespace {
+
+class BenchAction : public Action {
+public:
+    BenchAction(int priority) {
+        setPriority(priority);
+    }
+
+    void execute() {}
+};
+
+// Priorities of the activities in a simulation, weighted roughly as
+// they occur: mostly events, some clocks, a few syncs
+const int priorities[8] = {
+    EVENTPRIORITY, EVENTPRIORITY, EVENTPRIORITY, EVENTPRIORITY,
+    EVENTPRIORITY, CLOCKPRIORITY, CLOCKPRIORITY, SYNCPRIORITY
+};
+
+double
+seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool
+runHold(const std::string& engine, uint64_t pending, uint64_t ops)
+{
+    TimeVortex* tv = TimeVortex::getTimeVortex(engine);
+    if ( tv == NULL ) {
+        fprintf(stderr, "Unknown TimeVortex engine: %s\n", engine.c_str());
+        return false;
+    }
+
+    std::mt19937_64 rng(pending);
+    // Mean delay of 1000 core time units, with enough collisions on
+    // time to exercise the priority and queue order tie breaks
+    std::uniform_int_distribution<SimTime_t> delay(1, 2000);
+
+    std::vector<BenchAction*> actions;
+    actions.reserve(pending);
+    for ( uint64_t i = 0; i < pending; i++ ) {
+        actions.push_back(new BenchAction(priorities[i & 7]));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for ( uint64_t i = 0; i < pending; i++ ) {
+        actions[i]->setDeliveryTime(delay(rng));
+        tv->insert(actions[i]);
+    }
+    double fill = seconds(start);
+
+    uint64_t out_of_order = 0;
+    SimTime_t now = 0;
+    int now_priority = 0;
+    start = std::chrono::steady_clock::now();
+    for ( uint64_t i = 0; i < ops; i++ ) {
+        Activity* act = tv->pop();
+        SimTime_t time = act->getDeliveryTime();
+        if ( time < now || (time == now && act->getPriority() < now_priority) ) out_of_order++;
+        now = time;
+        now_priority = act->getPriority();
+        act->setDeliveryTime(time + delay(rng));
+        tv->insert(act);
+    }
+    double hold = seconds(start);
+
+    // The same, taking the activities out a batch (same time and
+    // priority) at a time, as the Simulation does
+    std::vector<Activity*> batch;
+    uint64_t done = 0;
+    start = std::chrono::steady_clock::now();
+    while ( done < ops ) {
+        batch.clear();
+        tv->popBatch(batch);
+        tv->closeBatch();
+        for ( size_t j = 0; j < batch.size(); j++ ) {
+            Activity* act = batch[j];
+            SimTime_t time = act->getDeliveryTime();
+            if ( time < now || (time == now && act->getPriority() < now_priority) ) out_of_order++;
+            if ( j > 0 && ( time != now || act->getPriority() != now_priority ||
+                            act->getQueueOrder() < batch[j-1]->getQueueOrder() ) ) out_of_order++;
+            now = time;
+            now_priority = act->getPriority();
+        }
+        for ( size_t j = 0; j < batch.size(); j++ ) {
+            batch[j]->setDeliveryTime(now + delay(rng));
+            tv->insert(batch[j]);
+        }
+        done += batch.size();
+    }
+    double batched = seconds(start);
+
+    printf("%-10s %12" PRIu64 " %12.1f %12.1f %12.1f %14.0f\n", engine.c_str(), pending,
+           fill * 1e9 / pending, hold * 1e9 / ops, batched * 1e9 / done, ops / hold);
+    if ( out_of_order != 0 ) {
+        printf("  ERROR: %" PRIu64 " activities delivered out of order\n", out_of_order);
+    }
+
+    // Deleting the queue doesn't delete what is in it
+    while ( !tv->empty() ) tv->pop();
+    delete tv;
+    for ( uint64_t i = 0; i < pending; i++ ) {
+        delete actions[i];
+    }
+    return out_of_order == 0;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t max_pending = argc > 1 ? (uint64_t)strtod(argv[1], NULL) : 1000000;
+    uint64_t ops = argc > 2 ? (uint64_t)strtod(argv[2], NULL) : 10000000;
+
+    std::vector<std::string> engines;
+    for ( int i = 3; i < argc; i++ ) {
+        engines.push_back(argv[i]);
+    }
+    if ( engines.empty() ) {
+        for ( auto it = TimeVortex::getDescriptionMap().begin(); it != TimeVortex::getDescriptionMap().end(); ++it ) {
+            engines.push_back(it->first);
+        }
+    }
+
+    printf("%-10s %12s %12s %12s %12s %14s\n", "engine", "pending", "ns/insert", "ns/hold", "ns/batched", "holds/s");
+    bool ok = true;
+    for ( uint64_t pending = 1000; pending <= max_pending; pending *= 10 ) {
+        for ( size_t i = 0; i < engines.size(); i++ ) {
+            ok = runHold(engines[i], pending, ops) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}
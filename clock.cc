@@ -15,17 +15,27 @@
 
 #include <boost/foreach.hpp>
 
+#include <algorithm>
+#include <typeindex>
+#include <typeinfo>
+
 //#include "sst/core/event.h"
 #include "sst/core/simulation.h"
 #include "sst/core/timeConverter.h"
     
 namespace SST {
 
+bool Clock::group_handlers = false;
+
 Clock::Clock( TimeConverter* period, int priority ) :
     Action(),
     currentCycle( 0 ),
     period( period ),
-    scheduled( false )
+    scheduled( false ),
+    num_removed( 0 ),
+    executing( false ),
+    regroup( false ),
+    has_checkpoint( false )
 {
     setPriority(priority);
 } 
@@ -34,6 +44,7 @@ Clock::Clock( TimeConverter* period, int priority ) :
 Clock::~Clock()
 {
     // Delete all the handlers
+    compact();
     for ( StaticHandlerMap_t::iterator it = staticHandlerMap.begin(); it != staticHandlerMap.end(); ++it ) {
         delete *it;
     }
@@ -44,6 +55,7 @@ Clock::~Clock()
 bool Clock::registerHandler( Clock::HandlerBase* handler )
 {
     staticHandlerMap.push_back( handler );	
+    if ( group_handlers ) regroup = true;
     if ( !scheduled ) {
         schedule();
     }
@@ -58,12 +70,20 @@ bool Clock::unregisterHandler( Clock::HandlerBase* handler, bool& empty )
 
     for ( ; iter != staticHandlerMap.end(); iter++ ) {
         if ( *iter == handler ) {
-            staticHandlerMap.erase( iter );
+            // A handler may unregister itself, or another handler, while
+            // the clock walks the list
+            if ( executing ) {
+                *iter = NULL;
+                num_removed++;
+            }
+            else {
+                staticHandlerMap.erase( iter );
+            }
             break;
         }
     }
   
-    empty = staticHandlerMap.empty();
+    empty = staticHandlerMap.size() == num_removed;
     
     return 0;
 }
@@ -88,15 +108,33 @@ void Clock::execute( void ) {
     // currentCycle = period->convertFromCoreTime(sim->getCurrentSimCycle());
     currentCycle++;
     
-    StaticHandlerMap_t::iterator sop_iter,start_iter,stop_iter;
-    //bool group = false;	//Scoggin(Jan23,2015) fix unused varialble warning in build
-    for ( sop_iter = staticHandlerMap.begin(); sop_iter != staticHandlerMap.end();  ) {
-    	Clock::HandlerBase* handler = *sop_iter;
-    	if ( (*handler)(currentCycle) ) sop_iter = staticHandlerMap.erase(sop_iter);
-    	else ++sop_iter;
-    	// (*handler)(currentCycle);
-    	// ++sop_iter;
+    // Run handlers of the same type together, so the calls through the
+    // vtable go to the same code one after another
+    if ( UNLIKELY(regroup) ) {
+        std::stable_sort(staticHandlerMap.begin(), staticHandlerMap.end(),
+                         [](Clock::HandlerBase* a, Clock::HandlerBase* b) {
+                             return std::type_index(typeid(*a)) < std::type_index(typeid(*b));
+                         });
+        regroup = false;
     }
+
+    // Handlers that are done are set to NULL and all removed at the
+    // end, rather than erased from the middle of the vector one by one.
+    // Handlers registered during the tick start on the next one.
+    bool profiling = Simulation::isProfiling();
+    size_t count = staticHandlerMap.size();
+    executing = true;
+    for ( size_t i = 0; i < count; i++ ) {
+    	Clock::HandlerBase* handler = staticHandlerMap[i];
+    	if ( handler == NULL ) continue;
+    	bool done = UNLIKELY(profiling) ? sim->executeProfiled(handler, currentCycle) : (*handler)(currentCycle);
+    	if ( done && staticHandlerMap[i] != NULL ) {
+    	    staticHandlerMap[i] = NULL;
+    	    num_removed++;
+    	}
+    }
+    executing = false;
+    compact();
     
     next = sim->getCurrentSimCycle() + period->getFactor();
     sim->insertActivity( next, this );
@@ -104,6 +142,15 @@ void Clock::execute( void ) {
     return;
 }
 
+void
+Clock::compact()
+{
+    if ( num_removed == 0 ) return;
+    staticHandlerMap.erase(std::remove(staticHandlerMap.begin(), staticHandlerMap.end(), (Clock::HandlerBase*)NULL),
+                           staticHandlerMap.end());
+    num_removed = 0;
+}
+
 void
 Clock::schedule()
 {
@@ -127,6 +174,31 @@ Clock::schedule()
     scheduled = true;
 }
 
+void
+Clock::saveCheckpoint()
+{
+    saved_cycle = currentCycle;
+    saved_handlers = staticHandlerMap;
+    saved_next = next;
+    saved_scheduled = scheduled;
+    has_checkpoint = true;
+}
+
+void
+Clock::restoreCheckpoint()
+{
+    if ( !has_checkpoint ) {
+        staticHandlerMap.clear();
+        scheduled = false;
+        return;
+    }
+    currentCycle = saved_cycle;
+    staticHandlerMap = saved_handlers;
+    if ( group_handlers ) regroup = true;
+    next = saved_next;
+    scheduled = saved_scheduled;
+}
+
 void
 Clock::print(const std::string& header, Output &out) const
 {
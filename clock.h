@@ -119,21 +119,52 @@ public:
     bool unregisterHandler( Clock::HandlerBase* handler, bool& empty );
 
     void print(const std::string& header, Output &out) const;
+
+    /** Set whether the handlers of each clock are kept grouped by
+     * type, so the same handler code runs back to back.  Handlers of
+     * different types then no longer run in the order they were
+     * registered. */
+    static void setGroupHandlers(bool group) { group_handlers = group; }
+
+    /** Save the state of the clock for optimistic execution (see
+     * Simulation::saveCheckpoint()) */
+    void saveCheckpoint();
+    /** Go back to the state saved by saveCheckpoint().  A clock with
+     * no saved state was created after the checkpoint, so it is left
+     * with no handlers and unscheduled. */
+    void restoreCheckpoint();
     
 private:
 /*     typedef std::list<Clock::HandlerBase*> HandlerMap_t; */
     typedef std::vector<Clock::HandlerBase*> StaticHandlerMap_t;
 
 
-    Clock() { }
+    Clock() : num_removed(0), executing(false), regroup(false) { }
 
     void execute( void );
+    /** Drop the handlers removed during execute() */
+    void compact();
 
     Cycle_t            currentCycle;
     TimeConverter*     period;
     StaticHandlerMap_t staticHandlerMap;
     SimTime_t          next;
     bool               scheduled;
+    /** Handlers set to NULL during execute(), removed at its end */
+    size_t             num_removed;
+    bool               executing;
+    /** Handlers were added since they were last grouped */
+    bool               regroup;
+
+    static bool        group_handlers;
+
+    Cycle_t            saved_cycle;
+    StaticHandlerMap_t saved_handlers;
+    SimTime_t          saved_next;
+    bool               saved_scheduled;
+    bool               has_checkpoint;
+
+    friend class ThreadLoadBalancer;
     
     friend class boost::serialization::access;
     template<class Archive>
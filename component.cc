@@ -103,6 +103,7 @@ Component::isPortValidForComponent(const std::string& comp_name, const std::stri
 
 TimeConverter* Component::registerClock( std::string freq, Clock::HandlerBase* handler, bool regAll) {
     TimeConverter* tc = getSimulation()->registerClock(freq,handler);
+    if ( Simulation::isProfiling() ) getSimulation()->setClockHandlerOwner(handler, getId());
     
     // if regAll is true set tc as the default for the component and
     // for all the links
@@ -123,6 +124,7 @@ TimeConverter* Component::registerClock( std::string freq, Clock::HandlerBase* h
 
 TimeConverter* Component::registerClock( const UnitAlgebra& freq, Clock::HandlerBase* handler, bool regAll) {
     TimeConverter* tc = getSimulation()->registerClock(freq,handler);
+    if ( Simulation::isProfiling() ) getSimulation()->setClockHandlerOwner(handler, getId());
     
     // if regAll is true set tc as the default for the component and
     // for all the links
@@ -154,10 +156,13 @@ void Component::unregisterClock(TimeConverter *tc, Clock::HandlerBase* handler)
 }
 
 TimeConverter* Component::registerOneShot( std::string timeDelay, OneShot::HandlerBase* handler) {
+    // OneShots can't be moved to another thread
+    getSimulation()->pinComponent(getId());
     return getSimulation()->registerOneShot(timeDelay, handler);
 }
 
 TimeConverter* Component::registerOneShot( const UnitAlgebra& timeDelay, OneShot::HandlerBase* handler) {
+    getSimulation()->pinComponent(getId());
     return getSimulation()->registerOneShot(timeDelay, handler);
 }
 
@@ -107,6 +107,25 @@ public:
      */
     virtual void printStatus(Output &out) { return; }
 
+    /**
+     * Called at the start of each speculative window when running
+     * optimistically (--optimistic-window).  Save whatever
+     * restoreCheckpoint() needs to put the component back to the
+     * current time, including the values of its statistics and its
+     * subcomponents.  Pending events and clock and one shot
+     * registrations are saved by the core.  The core doesn't run
+     * optimistically when statistics are output during the run, since
+     * written output can't be taken back.
+     * @return false if not supported, in which case the simulation
+     * runs conservatively
+     */
+    virtual bool saveCheckpoint() { return false; }
+    /** Go back to the state saved by the last saveCheckpoint() */
+    virtual void restoreCheckpoint() {}
+    /** The window started at the last saveCheckpoint() has been
+     * committed, so the saved state is no longer needed */
+    virtual void discardCheckpoint() {}
+
     /** Determine if a port name is connected to any links */
     bool isPortConnected(const std::string &name) const;
 
@@ -376,6 +395,7 @@ protected:
 private:
 
     friend class SubComponent;
+    friend class ThreadLoadBalancer;
 
     void addSelfLink(std::string name);
 
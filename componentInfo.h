@@ -129,6 +129,12 @@ public:
         dataByID.insert(info);
     }
 
+    /** Remove info from the map, without deleting it */
+    void erase(ComponentInfo* info) {
+        dataByName.erase(info);
+        dataByID.erase(info);
+    }
+
     ComponentInfo* getByName(const std::string& key) const {
         ComponentInfo infoKey(0, key, "", NULL);
         auto value = dataByName.find(&infoKey);
@@ -14,6 +14,7 @@
 #include "sst/core/serialization.h"
 #include "sst/core/config.h"
 #include "sst/core/part/sstpart.h"
+#include "sst/core/timeVortex.h"
 
 #include <errno.h>
 #include <iostream>
@@ -52,10 +53,14 @@ Config::Config(RankInfo rankInfo)
     stopAtCycle = "0 ns";
     timeBase    = "1 ps";
     heartbeatPeriod = "N";
+    optimisticWindow = "0 ns";
     partitioner = "linear";
+    timeVortex  = "pq";
     generator   = "NONE";
     generator_options   = "";
     dump_component_graph_file = "";
+    output_profile = "";
+    partition_profile = "";
     output_directory = "";
 #ifdef SST_CONFIG_HAVE_PYTHON
     model_options = "";
@@ -67,10 +72,24 @@ Config::Config(RankInfo rankInfo)
     enable_sig_handling = true;
     output_core_prefix = "@x SST Core: ";
     print_timing = false;
+    batch_dispatch = false;
+    link_fifo = false;
+    numa_placement = false;
+    async_rank_sync = false;
+    pairwise_thread_sync = false;
+    null_message_sync = false;
+    hybrid_barrier = false;
+    tree_barrier = false;
+    parallel_load = false;
+    group_clock_handlers = false;
+    load_balance = 0.0;
 
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     event_dump_file = "";
 #endif
+#ifdef USE_MEMPOOL
+    mempool_huge_pages = false;
+#endif
     
     // Some config items can be initialized from either the command line or
     // the config file. The command line has precedence. We need to initialize
@@ -84,6 +103,16 @@ Config::Config(RankInfo rankInfo)
         ("disable-signal-handlers", "disable SST automatic dynamic library environment configuration")
         ("no-env-config", "disable SST environment configuration")
         ("print-timing-info", "print SST timing information")
+        ("batch-dispatch", "pop all activities with the same time and priority from the event queue at once")
+        ("link-fifo", "keep pending events in a FIFO per link, with only the head of each FIFO in the event queue")
+        ("numa-placement", "bind each simulation thread to a cpu, spreading threads over NUMA nodes, and report the placement")
+        ("async-rank-sync", "overlap rank sync communication with simulation of the next half lookahead window")
+        ("pairwise-thread-sync", "synchronize each thread only with the threads it has links to, using the lookahead of each pair")
+        ("null-message-sync", "synchronize each rank only with the ranks it has links to, exchanging null messages with the lookahead of each pair")
+        ("hybrid-barrier", "threads waiting at a barrier spin for a time based on recent waits, then sleep, instead of spinning until released")
+        ("tree-barrier", "threads arriving at a barrier are combined in a tree instead of all updating one counter")
+        ("parallel-load", "every rank runs the model and keeps only the components it owns, so no rank holds the whole graph (only the linear and self partitioners are supported, and component weights are not used)")
+        ("group-clock-handlers", "run the handlers of each clock grouped by type instead of in the order they were registered")
         ("version,V", "print SST Release Version")
     ;
 
@@ -118,6 +147,20 @@ Config::Config(RankInfo rankInfo)
         part_desc.append("\n-  ").append(it->first).append(": ").append(it->second);
     }
     part_desc.append("\n-  lib.partitioner_name: Partitioner found in element library 'lib' with name 'partitioner_name'");
+
+    // Build the string for the TimeVortex help
+    string tv_desc;
+    tv_desc.append("event queue implementation to be used < ");
+    const map<string,string>& tvdesc = TimeVortex::getDescriptionMap();
+    prefix = "";
+    for ( map<string,string>::const_iterator it = tvdesc.begin(); it != tvdesc.end() ; ++it ) {
+        tv_desc.append(prefix).append(it->first);
+        prefix = " | ";
+    }
+    tv_desc.append(" >\nDescriptions:");
+    for ( map<string,string>::const_iterator it = tvdesc.begin(); it != tvdesc.end() ; ++it ) {
+        tv_desc.append("\n-  ").append(it->first).append(": ").append(it->second);
+    }
     mainDesc = new po::options_description( "" );
     mainDesc->add_options()
         ("debug-file", po::value <string> ( &debugFile ),
@@ -132,6 +175,8 @@ Config::Config(RankInfo rankInfo)
 	                        "set time at which simulation will end execution")
         ("heartbeat-period", po::value< string >(&heartbeatPeriod),
 				"Set time for heart beats to be published (these are approximate timings published by the core to update on progress), default is every 10000 simulated seconds")
+        ("optimistic-window", po::value< string >(&optimisticWindow),
+                                "EXPERIMENTAL: run threads speculatively in windows of this length.  Not Time Warp: each window saves every pending event, a late event rolls back all threads to the window start, and there are no anti-messages or per-component rollback.  Output written by components during a rolled back window is not undone, and Actions scheduled in it other than clocks and one shots are dropped.  Single rank only; needs components that implement saveCheckpoint(), Event types that implement serialization, no polling links and statistics output only at the end")
         ("timebase", po::value< string >(&timeBase), 
                                 "sets the base time step of the simulation (default: 1ps)")
 #ifdef SST_CONFIG_HAVE_MPI
@@ -139,6 +184,8 @@ Config::Config(RankInfo rankInfo)
          part_desc.c_str())
 #endif
 
+        ("time-vortex", po::value< string >(&timeVortex),
+         tv_desc.c_str())
         ("generator", po::value< string >(&generator),
          "generator to be used to build simulation <lib.generator_name>")
         ("gen-options", po::value< string >(&generator_options),
@@ -153,17 +200,24 @@ Config::Config(RankInfo rankInfo)
          "Controls where SST will place output files including debug output and simulation statistics, default is for SST to create a unique directory.")
     ("num_threads,n", po::value <uint32_t>(&world_size.thread),
      "Number of parallel threads to use per rank.")
+        ("load-balance", po::value< double >(&load_balance),
+         "While running, move components from the busiest thread to the least busy one when the busiest spends more than this many times the average in handlers (e.g. 1.2; default 0 is never)")
 #ifdef SST_CONFIG_HAVE_PYTHON
         ("model-options", po::value< string >(&model_options),
          "Provide options to the SST Python scripting engine (default is to provide no script options)")
 #endif
         ("output-partition", po::value< string >(&dump_component_graph_file),
          "Dump the component partition to this file (default is not to dump information)")
+        ("output-profile", po::value< string >(&output_profile),
+         "Count the handlers each component runs, the time they take and the events on each link, and write the counts to this file at the end of the run")
+        ("partition-profile", po::value< string >(&partition_profile),
+         "Weight the partition with the counts in this file, written by --output-profile in an earlier run of the same model")
 	("output-prefix-core", po::value< string >(&output_core_prefix),
 	 "Sets the SST::Output prefix for the core during execution")
 #ifdef USE_MEMPOOL
         ("output-undeleted-events", po::value<string>(&event_dump_file),
          "Outputs information about all undeleted events to the specified file at end of simulation (STDOUT and STDERR can be used to output to console on stdout and stderr")
+        ("mempool-huge-pages", "Back the event memory pools with huge pages (MAP_HUGETLB, falling back to transparent huge pages)")
 #endif
         ("output-xml", po::value< string >(&output_xml),
          "Dump the SST component and link configuration graph to this file (as an XML file), empty string (default) is not to dump anything.")
@@ -235,6 +289,19 @@ Config::parseCmdLine(int argc, char* argv[]) {
     verbose = var_map->count( "verbose" );
     enable_sig_handling = (var_map->count("disable-signal-handlers") > 0) ? false : true;
     print_timing = (var_map->count("print-timing-info") > 0);
+    batch_dispatch = (var_map->count("batch-dispatch") > 0);
+#ifdef USE_MEMPOOL
+    mempool_huge_pages = (var_map->count("mempool-huge-pages") > 0);
+#endif
+    link_fifo = (var_map->count("link-fifo") > 0);
+    numa_placement = (var_map->count("numa-placement") > 0);
+    async_rank_sync = (var_map->count("async-rank-sync") > 0);
+    pairwise_thread_sync = (var_map->count("pairwise-thread-sync") > 0);
+    null_message_sync = (var_map->count("null-message-sync") > 0);
+    hybrid_barrier = (var_map->count("hybrid-barrier") > 0);
+    tree_barrier = (var_map->count("tree-barrier") > 0);
+    parallel_load = (var_map->count("parallel-load") > 0);
+    group_clock_handlers = (var_map->count("group-clock-handlers") > 0);
 
     if ( var_map->count( "version" ) ) {
         cout << "SST Release Version (" PACKAGE_VERSION << ", " SST_SVN_REVISION ")" << endl;
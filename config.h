@@ -65,8 +65,10 @@ public:
     std::string     sdlfile;            /*!< Graph generation file */
     std::string     stopAtCycle;        /*!< When to stop the simulation */
     std::string     heartbeatPeriod;    /*!< Sets the heartbeat period for the simulation */
+    std::string     optimisticWindow;   /*!< Length of the speculative windows for optimistic execution ("0 ns" to run conservatively) */
     std::string     timeBase;           /*!< Timebase of simulation */
     std::string     partitioner;        /*!< Partitioner to use */
+    std::string     timeVortex;         /*!< TimeVortex implementation to use */
     std::string     generator;          /*!< Generator to use */
     std::string     generator_options;  /*!< Options to pass to the generator */
     std::string     output_config_graph;  /*!< File to dump configuration graph */
@@ -76,16 +78,30 @@ public:
     std::string     output_directory;   /*!< Output directory to dump all files to */
     std::string     model_options;      /*!< Options to pass to Python Model generator */
     std::string     dump_component_graph_file; /*!< File to dump component graph */
+    std::string     output_profile;     /*!< File to write the handler and link counts of the run to */
+    std::string     partition_profile;  /*!< Profile from an earlier run to weight the partition with */
     std::string     output_core_prefix;  /*!< Set the SST::Output prefix for the core */
 
     RankInfo        world_size;         /*!< Number of ranks, threads which should be invoked per rank */
     uint32_t        verbose;            /*!< Verbosity */
+    double          load_balance;       /*!< Move components off a thread this many times busier than the average (0 to never move them) */
     bool	    no_env_config;      /*!< Bypass compile-time environmental configuration */
     bool            enable_sig_handling; /*!< Enable signal handling */
     bool            print_timing;       /*!< Print SST timing information */
+    bool            batch_dispatch;     /*!< Dispatch same-timestamp activities as a batch */
+    bool            link_fifo;          /*!< Use per-link FIFO queues in front of the TimeVortex */
+    bool            numa_placement;     /*!< Bind simulation threads to cpus, spread over NUMA nodes */
+    bool            async_rank_sync;    /*!< Overlap rank sync communication with simulation */
+    bool            pairwise_thread_sync; /*!< Synchronize threads pairwise using per-pair lookahead */
+    bool            null_message_sync;  /*!< Synchronize ranks with null messages using per-rank-pair lookahead */
+    bool            hybrid_barrier;     /*!< Thread barriers spin for a while, then sleep */
+    bool            tree_barrier;       /*!< Thread barriers combine arrivals in a tree */
+    bool            parallel_load;      /*!< Every rank runs the model and keeps only its own part of the graph */
+    bool            group_clock_handlers; /*!< Run the handlers of each clock grouped by type */
 
 #ifdef USE_MEMPOOL
     std::string     event_dump_file;    /*!< File to dump undeleted events to */
+    bool            mempool_huge_pages; /*!< Back memory pool arenas with huge pages */
 #endif
     /** Set the run-mode
      * @param mode - string "init" "run" "both"
@@ -110,12 +126,16 @@ public:
 		std::cout << "libpath = " << getLibPath() << std::endl;
 		std::cout << "sdlfile = " << sdlfile << std::endl;
 		std::cout << "stopAtCycle = " << stopAtCycle << std::endl;
+		std::cout << "optimisticWindow = " << optimisticWindow << std::endl;
 		std::cout << "timeBase = " << timeBase << std::endl;
 		std::cout << "partitioner = " << partitioner << std::endl;
+		std::cout << "timeVortex = " << timeVortex << std::endl;
 		std::cout << "generator = " << generator << std::endl;
 		std::cout << "gen_options = " << generator_options << std::endl;
 		std::cout << "output_config_graph = " << output_config_graph << std::endl;
 		std::cout << "output_xml = " << output_xml << std::endl;
+		std::cout << "output_profile = " << output_profile << std::endl;
+		std::cout << "partition_profile = " << partition_profile << std::endl;
 		std::cout << "no_env_config = " << no_env_config << std::endl;
 		std::cout << "output_directory = " << output_directory << std::endl;
 		std::cout << "output_json = " << output_json << std::endl;
@@ -124,6 +144,17 @@ public:
 		std::cout << "enable_sig_handling = " << enable_sig_handling << std::endl;
 		std::cout << "output_core_prefix = " << output_core_prefix << std::endl;
       		std::cout << "print_timing=" << print_timing << std::endl;
+		std::cout << "batch_dispatch = " << batch_dispatch << std::endl;
+		std::cout << "link_fifo = " << link_fifo << std::endl;
+		std::cout << "numa_placement = " << numa_placement << std::endl;
+		std::cout << "async_rank_sync = " << async_rank_sync << std::endl;
+		std::cout << "pairwise_thread_sync = " << pairwise_thread_sync << std::endl;
+		std::cout << "null_message_sync = " << null_message_sync << std::endl;
+		std::cout << "hybrid_barrier = " << hybrid_barrier << std::endl;
+		std::cout << "tree_barrier = " << tree_barrier << std::endl;
+		std::cout << "parallel_load = " << parallel_load << std::endl;
+		std::cout << "group_clock_handlers = " << group_clock_handlers << std::endl;
+		std::cout << "load_balance = " << load_balance << std::endl;
 	}
 
     /** Return the library search path */
@@ -163,11 +194,15 @@ private:
         ar & BOOST_SERIALIZATION_NVP(addlLibPath);
         ar & BOOST_SERIALIZATION_NVP(sdlfile);
         ar & BOOST_SERIALIZATION_NVP(stopAtCycle);
+        ar & BOOST_SERIALIZATION_NVP(optimisticWindow);
         ar & BOOST_SERIALIZATION_NVP(timeBase);
         ar & BOOST_SERIALIZATION_NVP(partitioner);
+        ar & BOOST_SERIALIZATION_NVP(timeVortex);
         ar & BOOST_SERIALIZATION_NVP(generator);
         ar & BOOST_SERIALIZATION_NVP(generator_options);
         ar & BOOST_SERIALIZATION_NVP(dump_component_graph_file);
+        ar & BOOST_SERIALIZATION_NVP(output_profile);
+        ar & BOOST_SERIALIZATION_NVP(partition_profile);
         ar & BOOST_SERIALIZATION_NVP(output_config_graph);
 	ar & BOOST_SERIALIZATION_NVP(output_xml);
 	ar & BOOST_SERIALIZATION_NVP(output_json);
@@ -177,6 +212,17 @@ private:
 	ar & BOOST_SERIALIZATION_NVP(enable_sig_handling);
         ar & BOOST_SERIALIZATION_NVP(output_core_prefix);
         ar & BOOST_SERIALIZATION_NVP(print_timing);
+        ar & BOOST_SERIALIZATION_NVP(batch_dispatch);
+        ar & BOOST_SERIALIZATION_NVP(link_fifo);
+        ar & BOOST_SERIALIZATION_NVP(numa_placement);
+        ar & BOOST_SERIALIZATION_NVP(async_rank_sync);
+        ar & BOOST_SERIALIZATION_NVP(pairwise_thread_sync);
+        ar & BOOST_SERIALIZATION_NVP(null_message_sync);
+        ar & BOOST_SERIALIZATION_NVP(hybrid_barrier);
+        ar & BOOST_SERIALIZATION_NVP(tree_barrier);
+        ar & BOOST_SERIALIZATION_NVP(parallel_load);
+        ar & BOOST_SERIALIZATION_NVP(group_clock_handlers);
+        ar & BOOST_SERIALIZATION_NVP(load_balance);
     }
     
     int rank;
@@ -14,6 +14,7 @@
 #include "sst/core/serialization.h"
 #include <sst/core/configGraph.h>
 
+#include <algorithm>
 #include <fstream>
 #include <boost/format.hpp>
 
@@ -26,6 +27,7 @@
 
 #ifdef SST_CONFIG_HAVE_MPI
 #include <mpi.h>
+#include <sst/core/objectComms.h>
 #endif
 
 using namespace std;
@@ -242,35 +244,49 @@ ConfigGraph::checkForStructuralErrors()
 }
 
 
+void
+ConfigGraph::setLoadRank(uint32_t rank, uint32_t num_ranks)
+{
+    load_rank = rank;
+    load_ranks = num_ranks;
+}
+
 ComponentId_t
 ConfigGraph::addComponent(std::string name, std::string type, float weight, RankInfo rank)
 {
-	comps.push_back(ConfigComponent(nextCompID, name, type, weight, rank, false));
+    if ( isLoadLocal(nextCompID) ) {
+        comps.push_back(ConfigComponent(nextCompID, name, type, weight, rank, false));
+    }
     return nextCompID++;
 }
 
 ComponentId_t
 ConfigGraph::addComponent(std::string name, std::string type)
 {
-	comps.push_back(ConfigComponent(nextCompID, name, type, 1.0f, RankInfo(), false));
+    if ( isLoadLocal(nextCompID) ) {
+        comps.push_back(ConfigComponent(nextCompID, name, type, 1.0f, RankInfo(), false));
+    }
     return nextCompID++;
 }
 
 void
 ConfigGraph::setComponentRank(ComponentId_t comp_id, RankInfo rank)
 {
+    if ( !isLoadLocal(comp_id) ) return;
     comps[comp_id].rank = rank;
 }
 
 void
 ConfigGraph::setComponentWeight(ComponentId_t comp_id, float weight)
 {
+    if ( !isLoadLocal(comp_id) ) return;
 	comps[comp_id].weight = weight;
 }
 
 void
 ConfigGraph::addParams(ComponentId_t comp_id, Params& p)
 {
+    if ( !isLoadLocal(comp_id) ) return;
     bool bk = comps[comp_id].params.enableVerify(false);
     // comps[comp_id].params.insert(p.begin(),p.end());
     comps[comp_id].params.insert(p);
@@ -280,6 +296,7 @@ ConfigGraph::addParams(ComponentId_t comp_id, Params& p)
 void
 ConfigGraph::addParameter(ComponentId_t comp_id, const string key, const string value, bool overwrite)
 {
+    if ( !isLoadLocal(comp_id) ) return;
     bool bk = comps[comp_id].params.enableVerify(false);
 	// if ( overwrite ) {
 	// 	comps[comp_id].params[key] = value;
@@ -322,6 +339,7 @@ ConfigGraph::enableComponentStatistic(ComponentId_t comp_id, string statisticNam
     // NOTE: For every statistic in the enabledStatistics List, there must be
     //       a coresponding params entry in enabledStatParams list.  The two
     //       lists will always be the same size.  
+    if ( !isLoadLocal(comp_id) ) return;
     
     // Check for Enable All Statistics
     if (statisticName == STATALLFLAG) {
@@ -392,6 +410,7 @@ ConfigGraph::addComponentStatisticParameter(ComponentId_t comp_id, string statis
     // NOTE: For every statistic in the enabledStatistics List, there must be
     //       a coresponding params entry in enabledStatParams list.  The two
     //       lists will always be the same size.  
+    if ( !isLoadLocal(comp_id) ) return;
     
     // Scan the enabledStatistics list for the statistic name
     for (size_t x = 0; x < comps[comp_id].enabledStatistics.size(); x++) {
@@ -437,6 +456,9 @@ ConfigGraph::addStatisticParameterForComponentType(string ComponentType, string
 void
 ConfigGraph::addLink(ComponentId_t comp_id, string link_name, string port, string latency_str, bool no_cut)
 {
+    // The other end's rank adds the link for it
+    if ( !isLoadLocal(comp_id) ) return;
+
 	if ( link_names.find(link_name) == link_names.end() ) {
         LinkId_t id = links.size();
         link_names[link_name] = id;
@@ -461,7 +483,9 @@ ConfigGraph::addLink(ComponentId_t comp_id, string link_name, string port, strin
 ComponentId_t
 ConfigGraph::addIntrospector(string name, string type)
 {
-	comps.push_back(ConfigComponent(nextCompID, name, type, 0.0f, RankInfo(0, 0), true));
+    if ( isLoadLocal(nextCompID) ) {
+        comps.push_back(ConfigComponent(nextCompID, name, type, 0.0f, RankInfo(0, 0), true));
+    }
     return nextCompID++;
 
 }
@@ -684,6 +708,439 @@ ConfigGraph::getConnectedNoCutComps(ComponentId_t start, ComponentIdMap_t& group
     }
 }
 
+#ifdef SST_CONFIG_HAVE_MPI
+
+namespace {
+
+/* One end of a link, as loaded by the rank that kept its component */
+struct LinkEnd {
+    std::string   name;
+    ComponentId_t comp;
+    std::string   port;
+    SimTime_t     latency;
+    bool          no_cut;
+
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        ar & BOOST_SERIALIZATION_NVP(name);
+        ar & BOOST_SERIALIZATION_NVP(comp);
+        ar & BOOST_SERIALIZATION_NVP(port);
+        ar & BOOST_SERIALIZATION_NVP(latency);
+        ar & BOOST_SERIALIZATION_NVP(no_cut);
+    }
+};
+
+/* Rank of a component, with the lowest id found so far in its no-cut
+ * group */
+struct CompRank {
+    ComponentId_t comp;
+    ComponentId_t group;
+    RankInfo      rank;
+
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        ar & BOOST_SERIALIZATION_NVP(comp);
+        ar & BOOST_SERIALIZATION_NVP(group);
+        ar & BOOST_SERIALIZATION_NVP(rank);
+    }
+};
+
+}
+
+// Rank that puts a link together.  Only depends on the name, so all
+// the ranks with an end of the link pick the same one.
+static uint32_t
+linkHome(const std::string& name, uint32_t num_ranks)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for ( size_t i = 0; i < name.size(); i++ ) {
+        hash ^= (unsigned char)name[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash % num_ranks;
+}
+
+static bool
+compIdLess(const ConfigComponent& a, const ConfigComponent& b)
+{
+    return a.id < b.id;
+}
+
+static bool
+linkIdLess(const ConfigLink& a, const ConfigLink& b)
+{
+    return a.id < b.id;
+}
+
+void
+ConfigGraph::distributeParallelLoad(const RankInfo& world_size, bool self_partition)
+{
+    uint32_t my_rank = load_rank;
+    uint32_t num_ranks = load_ranks;
+
+    unifyParamKeys();
+    assembleParallelLinks(my_rank, num_ranks);
+    partitionParallelLoad(world_size, self_partition);
+
+    // Find the ranks of the components at the other end of the links
+    std::vector<std::vector<CompRank> > ranks_out(num_ranks);
+    for ( ConfigComponentMap_t::iterator iter = comps.begin(); iter != comps.end(); ++iter ) {
+        const ConfigComponent& comp = *iter;
+        CompRank note;
+        note.comp = comp.id;
+        note.group = comp.id;
+        note.rank = comp.rank;
+        for ( size_t i = 0; i < comp.links.size(); i++ ) {
+            const ConfigLink& link = links[comp.links[i]];
+            ComponentId_t remote = link.component[0] == comp.id ?
+                link.component[1] : link.component[0];
+            ranks_out[remote % num_ranks].push_back(note);
+        }
+    }
+    std::vector<std::vector<CompRank> > ranks_in;
+    Comms::all_to_all(ranks_out, ranks_in);
+    ranks_out.clear();
+
+    std::map<ComponentId_t, RankInfo> remote_ranks;
+    for ( size_t i = 0; i < ranks_in.size(); i++ ) {
+        for ( size_t j = 0; j < ranks_in[i].size(); j++ ) {
+            remote_ranks[ranks_in[i][j].comp] = ranks_in[i][j].rank;
+        }
+    }
+    ranks_in.clear();
+
+    // Send every component to its rank along with its links.  A
+    // component with links to other ranks is also sent to them,
+    // without its params, as getSubGraph() does.
+    std::vector<std::vector<ConfigComponent> > comps_out(num_ranks);
+    std::vector<std::vector<ConfigLink> > links_out(num_ranks);
+    for ( ConfigComponentMap_t::iterator iter = comps.begin(); iter != comps.end(); ++iter ) {
+        const ConfigComponent& comp = *iter;
+        comps_out[comp.rank.rank].push_back(comp);
+
+        std::set<uint32_t> border_ranks;
+        for ( size_t i = 0; i < comp.links.size(); i++ ) {
+            const ConfigLink& link = links[comp.links[i]];
+            links_out[comp.rank.rank].push_back(link);
+
+            ComponentId_t remote = link.component[0] == comp.id ?
+                link.component[1] : link.component[0];
+            uint32_t remote_rank = remote_ranks[remote].rank;
+            if ( remote_rank != comp.rank.rank ) border_ranks.insert(remote_rank);
+        }
+        for ( std::set<uint32_t>::iterator r = border_ranks.begin(); r != border_ranks.end(); ++r ) {
+            comps_out[*r].push_back(comp.cloneWithoutLinksOrParams());
+        }
+    }
+    remote_ranks.clear();
+    comps.clear();
+    links.clear();
+
+    std::vector<std::vector<ConfigComponent> > comps_in;
+    Comms::all_to_all(comps_out, comps_in);
+    comps_out.clear();
+    std::vector<std::vector<ConfigLink> > links_in;
+    Comms::all_to_all(links_out, links_in);
+    links_out.clear();
+
+    // SparseVectorMap is slow at random inserts, so sort first.  Each
+    // component comes from one rank only, but a link with both ends
+    // on this rank may come from two.
+    std::vector<ConfigComponent> new_comps;
+    for ( size_t i = 0; i < comps_in.size(); i++ ) {
+        new_comps.insert(new_comps.end(), comps_in[i].begin(), comps_in[i].end());
+    }
+    comps_in.clear();
+    std::sort(new_comps.begin(), new_comps.end(), compIdLess);
+    for ( size_t i = 0; i < new_comps.size(); i++ ) {
+        comps.push_back(new_comps[i]);
+    }
+    new_comps.clear();
+
+    std::vector<ConfigLink> new_links;
+    for ( size_t i = 0; i < links_in.size(); i++ ) {
+        new_links.insert(new_links.end(), links_in[i].begin(), links_in[i].end());
+    }
+    links_in.clear();
+    std::sort(new_links.begin(), new_links.end(), linkIdLess);
+    for ( size_t i = 0; i < new_links.size(); i++ ) {
+        if ( i > 0 && new_links[i].id == new_links[i-1].id ) continue;
+        const ConfigLink& link = new_links[i];
+        links.push_back(link);
+
+        // Components from other ranks came without their links
+        for ( int j = 0; j < 2; j++ ) {
+            ConfigComponent& comp = comps[link.component[j]];
+            if ( comp.rank.rank != my_rank ) comp.links.push_back(link.id);
+        }
+    }
+}
+
+void
+ConfigGraph::unifyParamKeys()
+{
+    // Keys get ids in the order they are first used, which differs
+    // between ranks that loaded different components.  Merge the maps
+    // in rank order, which leaves rank 0's ids as they are.
+    std::vector<std::vector<std::string> > all_keys;
+    Comms::all_gather(Params::keyMapReverse, all_keys);
+
+    std::map<std::string, uint32_t> key_map;
+    std::vector<std::string> key_map_reverse;
+    for ( size_t i = 0; i < all_keys.size(); i++ ) {
+        for ( size_t j = 0; j < all_keys[i].size(); j++ ) {
+            const std::string& key = all_keys[i][j];
+            if ( key_map.find(key) != key_map.end() ) continue;
+            key_map[key] = key_map_reverse.size();
+            key_map_reverse.push_back(key);
+        }
+    }
+
+    std::vector<uint32_t> new_ids(Params::keyMapReverse.size());
+    for ( size_t i = 0; i < new_ids.size(); i++ ) {
+        new_ids[i] = key_map[Params::keyMapReverse[i]];
+    }
+
+    for ( ConfigComponentMap_t::iterator iter = comps.begin(); iter != comps.end(); ++iter ) {
+        remapParamKeys(iter->params, new_ids);
+        for ( size_t i = 0; i < iter->enabledStatParams.size(); i++ ) {
+            remapParamKeys(iter->enabledStatParams[i], new_ids);
+        }
+    }
+    remapParamKeys(statOutputParams, new_ids);
+
+    Params::keyMap.swap(key_map);
+    Params::keyMapReverse.swap(key_map_reverse);
+    Params::nextKeyID = Params::keyMapReverse.size();
+}
+
+void
+ConfigGraph::remapParamKeys(Params& params, const std::vector<uint32_t>& new_ids)
+{
+    std::map<uint32_t, std::string> data;
+    for ( std::map<uint32_t, std::string>::const_iterator i = params.data.begin(); i != params.data.end(); ++i ) {
+        data[new_ids[i->first]] = i->second;
+    }
+    params.data.swap(data);
+}
+
+void
+ConfigGraph::assembleParallelLinks(uint32_t my_rank, uint32_t num_ranks)
+{
+    Output& output = Output::getDefaultObject();
+    TimeLord* timeLord = Simulation::getTimeLord();
+
+    // Send the ends loaded here to the ranks that put the links
+    // together
+    std::vector<std::vector<LinkEnd> > ends_out(num_ranks);
+    for ( ConfigLinkMap_t::iterator iter = links.begin(); iter != links.end(); ++iter ) {
+        const ConfigLink& link = *iter;
+        std::vector<LinkEnd>& out = ends_out[linkHome(link.name, num_ranks)];
+        for ( int i = 0; i < link.current_ref; i++ ) {
+            LinkEnd end;
+            end.name = link.name;
+            end.comp = link.component[i];
+            end.port = link.port[i];
+            end.latency = timeLord->getSimCycles(link.latency_str[i], __FUNCTION__);
+            end.no_cut = link.no_cut;
+            out.push_back(end);
+        }
+    }
+    std::vector<std::vector<LinkEnd> > ends_in;
+    Comms::all_to_all(ends_out, ends_in);
+    ends_out.clear();
+
+    std::map<std::string, std::vector<LinkEnd> > link_ends;
+    for ( size_t i = 0; i < ends_in.size(); i++ ) {
+        for ( size_t j = 0; j < ends_in[i].size(); j++ ) {
+            link_ends[ends_in[i][j].name].push_back(ends_in[i][j]);
+        }
+    }
+    ends_in.clear();
+
+    // Ids are given out in rank order, then in name order on each rank
+    uint64_t count = link_ends.size();
+    uint64_t first_id = 0;
+    MPI_Exscan(&count, &first_id, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+    if ( my_rank == 0 ) first_id = 0;
+
+    // Send each link to the ranks that kept its components
+    std::vector<std::vector<ConfigLink> > links_out(num_ranks);
+    LinkId_t id = first_id;
+    for ( std::map<std::string, std::vector<LinkEnd> >::iterator iter = link_ends.begin();
+          iter != link_ends.end(); ++iter, ++id ) {
+        const std::vector<LinkEnd>& ends = iter->second;
+        if ( ends.size() == 1 ) {
+            output.fatal(CALL_INFO, -1, "Found dangling link: %s.  It is connected on one side to component id %" PRIu64 ".\n",
+                         iter->first.c_str(), (uint64_t)ends[0].comp);
+        }
+        if ( ends.size() > 2 ) {
+            output.fatal(CALL_INFO, -1, "Link %s referenced more than two times\n", iter->first.c_str());
+        }
+
+        ConfigLink link(id, iter->first);
+        for ( int i = 0; i < 2; i++ ) {
+            link.component[i] = ends[i].comp;
+            link.port[i] = ends[i].port;
+            link.latency[i] = ends[i].latency;
+            link.no_cut = link.no_cut | ends[i].no_cut;
+        }
+        link.current_ref = 2;
+
+        uint32_t home0 = link.component[0] % num_ranks;
+        uint32_t home1 = link.component[1] % num_ranks;
+        links_out[home0].push_back(link);
+        if ( home1 != home0 ) links_out[home1].push_back(link);
+    }
+    link_ends.clear();
+
+    std::vector<std::vector<ConfigLink> > links_in;
+    Comms::all_to_all(links_out, links_in);
+    links_out.clear();
+
+    std::vector<ConfigLink> new_links;
+    for ( size_t i = 0; i < links_in.size(); i++ ) {
+        new_links.insert(new_links.end(), links_in[i].begin(), links_in[i].end());
+    }
+    links_in.clear();
+    std::sort(new_links.begin(), new_links.end(), linkIdLess);
+
+    std::map<std::string, LinkId_t> new_ids;
+    for ( size_t i = 0; i < new_links.size(); i++ ) {
+        new_ids[new_links[i].name] = new_links[i].id;
+    }
+    for ( ConfigComponentMap_t::iterator iter = comps.begin(); iter != comps.end(); ++iter ) {
+        for ( size_t i = 0; i < iter->links.size(); i++ ) {
+            iter->links[i] = new_ids[links[iter->links[i]].name];
+        }
+    }
+
+    links.clear();
+    link_names.clear();
+    for ( size_t i = 0; i < new_links.size(); i++ ) {
+        links.push_back(new_links[i]);
+    }
+}
+
+void
+ConfigGraph::partitionParallelLoad(const RankInfo& world_size, bool self_partition)
+{
+    uint32_t num_ranks = load_ranks;
+
+    // Unless the model gave the ranks itself, components are split into
+    // blocks of consecutive ids, one per thread, as the linear
+    // partitioner does: the first blocks take one extra component each
+    // until the remainder is used up.  Every rank knows how many ids
+    // were given out, so no communication is needed.
+    uint64_t num_slots = (uint64_t)world_size.rank * world_size.thread;
+    uint64_t per_slot = nextCompID / num_slots;
+    uint64_t remainder = nextCompID % num_slots;
+    std::map<ComponentId_t, CompRank> groups;
+    for ( ConfigComponentMap_t::iterator iter = comps.begin(); iter != comps.end(); ++iter ) {
+        ConfigComponent& comp = *iter;
+        if ( !self_partition ) {
+            uint64_t slot;
+            if ( comp.id < remainder * (per_slot + 1) ) {
+                slot = comp.id / (per_slot + 1);
+            }
+            else {
+                slot = remainder + (comp.id - remainder * (per_slot + 1)) / per_slot;
+            }
+            comp.rank = RankInfo(slot / world_size.thread, slot % world_size.thread);
+        }
+
+        for ( size_t i = 0; i < comp.links.size(); i++ ) {
+            if ( !links[comp.links[i]].no_cut ) continue;
+            CompRank& group = groups[comp.id];
+            group.comp = comp.id;
+            group.group = comp.id;
+            group.rank = comp.rank;
+            break;
+        }
+    }
+
+    // Components joined by no-cut links go where the lowest id in the
+    // group went.  That id is passed along the no-cut links until no
+    // rank sees a lower one.
+    while ( true ) {
+        std::vector<std::vector<CompRank> > groups_out(num_ranks);
+        for ( std::map<ComponentId_t, CompRank>::iterator iter = groups.begin(); iter != groups.end(); ++iter ) {
+            const ConfigComponent& comp = comps[iter->first];
+            for ( size_t i = 0; i < comp.links.size(); i++ ) {
+                const ConfigLink& link = links[comp.links[i]];
+                if ( !link.no_cut ) continue;
+                CompRank note = iter->second;
+                note.comp = link.component[0] == comp.id ? link.component[1] : link.component[0];
+                groups_out[note.comp % num_ranks].push_back(note);
+            }
+        }
+        std::vector<std::vector<CompRank> > groups_in;
+        Comms::all_to_all(groups_out, groups_in);
+
+        int changed = 0;
+        for ( size_t i = 0; i < groups_in.size(); i++ ) {
+            for ( size_t j = 0; j < groups_in[i].size(); j++ ) {
+                const CompRank& note = groups_in[i][j];
+                CompRank& group = groups[note.comp];
+                if ( note.group < group.group ) {
+                    group.group = note.group;
+                    group.rank = note.rank;
+                    changed = 1;
+                }
+            }
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if ( !changed ) break;
+    }
+
+    for ( std::map<ComponentId_t, CompRank>::iterator iter = groups.begin(); iter != groups.end(); ++iter ) {
+        comps[iter->first].rank = iter->second.rank;
+    }
+}
+
+#endif
+
+ConfigGraphThreadIndex::ConfigGraphThreadIndex(ConfigGraph& graph, uint32_t rank, uint32_t num_threads) :
+    comps(num_threads),
+    links(num_threads),
+    cross_thread_links(0),
+    inter_thread_min_latency(MAX_SIMTIME_T)
+{
+    ConfigComponentMap_t& comp_map = graph.getComponentMap();
+    for ( ConfigComponentMap_t::iterator iter = comp_map.begin(); iter != comp_map.end(); ++iter ) {
+        ConfigComponent* ccomp = &(*iter);
+        if ( ccomp->isIntrospector ) {
+            // Every thread creates its own
+            for ( uint32_t i = 0; i < num_threads; i++ ) comps[i].push_back(ccomp);
+        }
+        else if ( ccomp->rank.rank == rank ) {
+            comps[ccomp->rank.thread].push_back(ccomp);
+        }
+    }
+
+    ConfigLinkMap_t& link_map = graph.getLinkMap();
+    for ( ConfigLinkMap_t::iterator iter = link_map.begin(); iter != link_map.end(); ++iter ) {
+        ConfigLink* clink = &(*iter);
+        const RankInfo& rank0 = comp_map[clink->component[0]].rank;
+        const RankInfo& rank1 = comp_map[clink->component[1]].rank;
+
+        if ( rank0.rank == rank ) links[rank0.thread].push_back(clink);
+        if ( rank1.rank == rank && rank1 != rank0 ) links[rank1.thread].push_back(clink);
+
+        if ( rank0.rank == rank && rank1.rank == rank && rank0.thread != rank1.thread ) {
+            cross_thread_links++;
+            if ( clink->getMinLatency() < inter_thread_min_latency ) {
+                inter_thread_min_latency = clink->getMinLatency();
+            }
+        }
+    }
+}
+
 void
 PartitionComponent::print(std::ostream &os, const PartitionGraph* graph) const
 {
@@ -54,6 +54,7 @@ public:
     std::string      latency_str[2];/*!< Temp string holding latency */
     int              current_ref;   /*!< Number of components currently referring to this Link */
     bool             no_cut;        /*!< If set to true, partitioner will not make a cut through this Link */
+    uint64_t         event_count;   /*!< Events sent on this Link in a profiled run, 0 if not known */
 
     // inline const std::string& key() const { return name; }
     inline LinkId_t key() const { return id; }
@@ -81,7 +82,8 @@ private:
     friend class ConfigGraph;
     ConfigLink(LinkId_t id) :
         id(id),
-        no_cut(false)
+        no_cut(false),
+        event_count(0)
     {
         current_ref = 0;
 
@@ -92,7 +94,8 @@ private:
 
     ConfigLink(LinkId_t id, const std::string &n) :
         id(id),
-        no_cut(false)
+        no_cut(false),
+        event_count(0)
     {
         current_ref = 0;
         name = n;
@@ -116,6 +119,8 @@ private:
         ar & BOOST_SERIALIZATION_NVP(port);
         ar & BOOST_SERIALIZATION_NVP(latency);
         ar & BOOST_SERIALIZATION_NVP(current_ref);
+        ar & BOOST_SERIALIZATION_NVP(no_cut);
+        ar & BOOST_SERIALIZATION_NVP(event_count);
     }
 
 
@@ -210,6 +215,8 @@ public:
         links.clear();
         comps.clear();
         nextCompID = 0;
+        load_rank = 0;
+        load_ranks = 1;
         // Init the statistic output settings
         statOutputName = STATISTICSDEFAULTOUTPUTNAME;
         statLoadLevel = STATISTICSDEFAULTLOADLEVEL;
@@ -224,6 +231,27 @@ public:
     /** Verify that all components have valid Ranks assigned */
     bool checkRanks(RankInfo ranks);
 
+    /** Only keep the components loaded by one rank when every rank
+     * runs the model.  Ids are still given out to all components, so
+     * every rank must create them in the same order.  Calls for a
+     * component that isn't kept are ignored. */
+    void setLoadRank(uint32_t rank, uint32_t num_ranks);
+    /** Is the component kept by this rank while the model is loaded? */
+    bool isLoadLocal(ComponentId_t comp_id) const { return comp_id % load_ranks == load_rank; }
+
+#ifdef SST_CONFIG_HAVE_MPI
+    /** Turn the parts of the model loaded on each rank into the parts
+     * each rank runs.  Links are assembled and numbered, components
+     * are partitioned, then every rank gets its own components and
+     * links plus copies of the components they connect to on other
+     * ranks, as getSubGraph() would give it.  Must be called by all
+     * ranks.
+     * @param self_partition - keep the ranks set by the model, as the
+     * self partitioner does, instead of splitting the ids as the
+     * linear partitioner does */
+    void distributeParallelLoad(const RankInfo& world_size, bool self_partition);
+#endif
+
 
     // API for programatic initialization
     /** Create a new component with weight and rank */
@@ -308,11 +336,25 @@ private:
     std::map<std::string,LinkId_t> link_names;
     
     ComponentId_t  nextCompID;
-    
+
+    uint32_t       load_rank;
+    uint32_t       load_ranks;
+
     std::string statOutputName;
     Params      statOutputParams;
     uint8_t     statLoadLevel;
 
+#ifdef SST_CONFIG_HAVE_MPI
+    /** Give parameter keys the same ids on all ranks */
+    void unifyParamKeys();
+    static void remapParamKeys(Params& params, const std::vector<uint32_t>& new_ids);
+    /** Number the links and replace the ones loaded here with the
+     * whole links of the components kept by this rank */
+    void assembleParallelLinks(uint32_t my_rank, uint32_t num_ranks);
+    /** Give every kept component a rank and thread */
+    void partitionParallelLoad(const RankInfo& world_size, bool self_partition);
+#endif
+
     friend class boost::serialization::access;
     template<class Archive>
     void
@@ -331,6 +373,34 @@ private:
 
 };
 
+
+/**
+ * The components and links of one rank, bucketed by thread.  Built
+ * once before wireup so that the threads can wire up concurrently,
+ * each walking only its own part of the graph.  Each bucket is in id
+ * order, the same order a walk over the whole graph would give.
+ */
+class ConfigGraphThreadIndex {
+public:
+    ConfigGraphThreadIndex(ConfigGraph& graph, uint32_t rank, uint32_t num_threads);
+
+    /** Components on a thread, along with all the Introspectors */
+    const std::vector<ConfigComponent*>& getComponents(uint32_t thread) const { return comps[thread]; }
+    /** Links with at least one end on a thread */
+    const std::vector<ConfigLink*>& getLinks(uint32_t thread) const { return links[thread]; }
+
+    /** Number of links between two threads of the rank */
+    uint64_t getNumCrossThreadLinks() const { return cross_thread_links; }
+    /** Minimum latency of the links between two threads of the rank */
+    SimTime_t getInterThreadMinLatency() const { return inter_thread_min_latency; }
+
+private:
+    std::vector<std::vector<ConfigComponent*> > comps;
+    std::vector<std::vector<ConfigLink*> > links;
+    uint64_t cross_thread_links;
+    SimTime_t inter_thread_min_latency;
+};
+
     
 class PartitionComponent {
 public:
@@ -366,6 +436,7 @@ public:
     ComponentId_t             component[2];
     SimTime_t                 latency[2];
     bool                      no_cut;
+    uint64_t                  event_count;
 
     PartitionLink(const ConfigLink& cl) {
         id = cl.id;
@@ -374,6 +445,7 @@ public:
         latency[0] = cl.latency[0];
         latency[1] = cl.latency[1];
         no_cut = cl.no_cut;
+        event_count = cl.event_count;
     }
 
     inline const LinkId_t key() const { return id; }
@@ -28,6 +28,11 @@ Event::~Event() {}
 
 void Event::execute(void)
 {
+    delivery_link->advanceFifo(this);
+    if ( UNLIKELY( Simulation::isProfiling() ) ) {
+        delivery_link->deliverEventProfiled(this);
+        return;
+    }
     delivery_link->deliverEvent(this);
 }
 
@@ -52,6 +57,7 @@ void Event::serialize(Archive & ar, const unsigned int version)
 #ifndef SST_ENFORCE_EVENT_ORDERING
     ar & BOOST_SERIALIZATION_NVP(link_id);
 #endif
+    ar & BOOST_SERIALIZATION_NVP(sync_index);
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     ar & BOOST_SERIALIZATION_NVP(first_comp);
     ar & BOOST_SERIALIZATION_NVP(first_type);
@@ -64,6 +70,7 @@ void Event::serialize(Archive & ar, const unsigned int version)
 
 void NullEvent::execute(void)
 {
+    delivery_link->advanceFifo(this);
     delivery_link->deliverEvent(NULL);
     delete this;
 }
@@ -79,6 +86,7 @@ void NullEvent::serialize(Archive & ar, const unsigned int version)
 #ifdef USE_MEMPOOL
 std::mutex Activity::poolMutex;
 std::vector<Activity::PoolInfo_t> Activity::memPools;
+thread_local Core::MemPool* Activity::threadPools[Activity::POOL_SIZE_CLASSES];
 #endif
 
 
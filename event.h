@@ -72,6 +72,17 @@ public:
         delivery_link = NULL;
     }
 
+    /** Sets the index the sync on the receiving thread or rank uses to
+     * find its end of the link.  For use by SST Core only */
+    inline void setSyncIndex(LinkId_t index) {
+        sync_index = index;
+    }
+
+    /** Gets the sync index set by setSyncIndex().  For use by SST Core only */
+    inline LinkId_t getSyncIndex(void) const {
+        return sync_index;
+    }
+
     /** Gets the link id associated with this event.  For use by SST Core only */
     inline LinkId_t getLinkId(void) const {
 #ifdef SST_ENFORCE_EVENT_ORDERING
@@ -186,6 +197,7 @@ public:
 #ifndef SST_ENFORCE_EVENT_ORDERING        
         ser & link_id;
 #endif
+        ser & sync_index;
 #ifdef __SST_DEBUG_EVENT_TRACKING__
         ser & first_comp;
         ser & first_type;
@@ -213,6 +225,7 @@ private:
 #ifndef SST_ENFORCE_EVENT_ORDERING
     LinkId_t link_id;
 #endif
+    LinkId_t sync_index;
     
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     std::string first_comp;
@@ -32,9 +32,11 @@ Exit::Exit( int num_threads, TimeConverter* period, bool single_rank ) :
 //     m_functor( new EventHandler<Exit,bool,Event*> (this,&Exit::handler ) ),
     num_threads(num_threads),
     m_refCount( 0 ),
+    global_count( 1 ),
     m_period( period ),
     end_time(0),
-    single_rank(single_rank)
+    single_rank(single_rank),
+    check_pending(false)
 {
     setPriority(EXITPRIORITY);
     m_thread_counts = new unsigned int[num_threads];
@@ -131,6 +133,26 @@ unsigned int Exit::getRefCount() {
     return m_refCount;
 }
 
+void Exit::saveCheckpoint()
+{
+    std::lock_guard<Spinlock> lock(slock);
+    saved_refCount = m_refCount;
+    saved_thread_counts.assign(m_thread_counts, m_thread_counts + num_threads);
+    saved_idSet = m_idSet;
+    saved_end_time = end_time;
+}
+
+void Exit::restoreCheckpoint()
+{
+    std::lock_guard<Spinlock> lock(slock);
+    m_refCount = saved_refCount;
+    for ( int i = 0; i < num_threads; i++ ) {
+        m_thread_counts[i] = saved_thread_counts[i];
+    }
+    m_idSet = saved_idSet;
+    end_time = saved_end_time;
+}
+
 
 void
 Exit::execute()
@@ -142,6 +164,76 @@ Exit::execute()
     
 }
     
+void Exit::checkAsync()
+{
+#if defined(SST_CONFIG_HAVE_MPI) && MPI_VERSION >= 3
+    if ( single_rank ) {
+        check();
+        return;
+    }
+
+    // Active count and end time are reduced together with MPI_MAX, so
+    // global_count is only non-zero while some rank is still active.
+    global_count = 1;
+    if ( check_pending ) {
+        MPI_Wait(&check_req, MPI_STATUS_IGNORE);
+        check_pending = false;
+        global_count = check_out[0];
+        if ( !global_count ) {
+            // Every rank sees the same result, so none of them start
+            // another reduction
+            end_time = check_out[1];
+            return;
+        }
+    }
+
+    startCheck();
+#else
+    check();
+#endif
+}
+
+void Exit::startCheck()
+{
+#if defined(SST_CONFIG_HAVE_MPI) && MPI_VERSION >= 3
+    if ( single_rank ) {
+        check();
+        return;
+    }
+
+    getCheckInput(check_in);
+    MPI_Iallreduce( check_in, check_out, 2, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD, &check_req );
+    check_pending = true;
+#else
+    check();
+#endif
+}
+
+bool Exit::testCheck()
+{
+#if defined(SST_CONFIG_HAVE_MPI) && MPI_VERSION >= 3
+    if ( !check_pending ) return true;
+
+    int flag;
+    MPI_Test(&check_req, &flag, MPI_STATUS_IGNORE);
+    if ( !flag ) return false;
+
+    check_pending = false;
+    setCheckResult(check_out);
+#endif
+    return true;
+}
+
+void Exit::finishCheck()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( check_pending ) {
+        MPI_Wait(&check_req, MPI_STATUS_IGNORE);
+        check_pending = false;
+    }
+#endif
+}
+    
 // bool Exit::handler( Event* e )
 void Exit::check()
 {
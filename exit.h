@@ -16,6 +16,11 @@
 #include <sst/core/serialization.h>
 
 #include <unordered_set>
+#include <vector>
+
+#ifdef SST_CONFIG_HAVE_MPI
+#include <mpi.h>
+#endif
 
 #include <sst/core/action.h>
 
@@ -60,6 +65,35 @@ public:
     
     void execute(void);
     void check();
+    /** Non-blocking form of check().  Finishes the reduction started
+     * by the previous call and starts a new one, so an exit is seen
+     * one call later than with check(). */
+    void checkAsync();
+    /** Complete a reduction left outstanding by checkAsync() */
+    void finishCheck();
+    /** Save the reference counts for optimistic execution.  Called by
+     * one thread while all the others are stopped. */
+    void saveCheckpoint();
+    /** Go back to the counts saved by saveCheckpoint() */
+    void restoreCheckpoint();
+    /** Start the reduction done by check() without waiting for it.
+     * The result is picked up with testCheck(). */
+    void startCheck();
+    /** Returns true, and updates the global count and end time, once
+     * the reduction started by startCheck() is complete */
+    bool testCheck();
+    /** Fill in this rank's part of an exit check done by a rank sync
+     * as part of another reduction.  Both values are reduced with
+     * MPI_MAX. */
+    void getCheckInput(uint64_t* in) {
+        in[0] = ( m_refCount > 0 );
+        in[1] = end_time;
+    }
+    /** Take the result of an exit check started with getCheckInput() */
+    void setCheckResult(const uint64_t* out) {
+        global_count = out[0];
+        if ( !global_count ) end_time = out[1];
+    }
 
     void print(const std::string& header, Output &out) const {
         out.output("%s Exit Action to be delivered at %" PRIu64 " with priority %d\n",
@@ -86,9 +120,21 @@ private:
     std::unordered_set<ComponentId_t> m_idSet;
     SimTime_t end_time;
 
+    unsigned int    saved_refCount;
+    std::vector<unsigned int> saved_thread_counts;
+    std::unordered_set<ComponentId_t> saved_idSet;
+    SimTime_t saved_end_time;
+
     Core::ThreadSafe::Spinlock slock;
     
     bool single_rank;
+
+    bool check_pending;
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Request check_req;
+    uint64_t check_in[2];
+    uint64_t check_out[2];
+#endif
     
     friend class boost::serialization::access;
     template<class Archive>
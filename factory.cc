@@ -42,6 +42,7 @@ using namespace SST::Statistics;
 namespace SST {
 
 Factory* Factory::instance = NULL;
+thread_local std::string Factory::loadingComponentType;
 
 Factory::Factory(std::string searchPaths) :
     searchPaths(searchPaths),
@@ -65,12 +66,13 @@ Factory::GetComponentAllowedPorts(std::string type) {
     boost::tie(elemlib, elem) = parseLoadName(type);
 
     // ensure library is already loaded...
-    if (loaded_libraries.find(elemlib) == loaded_libraries.end()) {
-        findLibrary(elemlib);
-    }
+    requireLibrary(elemlib);
 
     // now look for component
     std::string tmp = elemlib + "." + elem;
+
+    std::lock_guard<std::recursive_mutex> lock(factoryMutex);
+
     eic_map_t::iterator eii = 
         found_components.find(tmp);
     if (eii == found_components.end()) {
@@ -98,15 +100,21 @@ Factory::CreateComponent(ComponentId_t id,
     // now look for component
     std::string tmp = elemlib + "." + elem;
 
-    std::lock_guard<std::recursive_mutex> lock(factoryMutex);
+    // Entries in the maps are never changed once they are added, so
+    // the lock is only needed for the lookup.  The threads can then
+    // build their components at the same time.
+    const ComponentInfo* cinfo;
+    {
+        std::lock_guard<std::recursive_mutex> lock(factoryMutex);
 
-    eic_map_t::iterator eii = found_components.find(tmp);
-    if (eii == found_components.end()) {
-        out.fatal(CALL_INFO, -1,"can't find requested component %s.\n ", tmp.c_str());
-        return NULL;
+        eic_map_t::iterator eii = found_components.find(tmp);
+        if (eii == found_components.end()) {
+            out.fatal(CALL_INFO, -1,"can't find requested component %s.\n ", tmp.c_str());
+            return NULL;
+        }
+        cinfo = &eii->second;
     }
-
-    const ComponentInfo ci = eii->second;
+    const ComponentInfo& ci = *cinfo;
 
     LinkMap *lm = Simulation::getSimulation()->getComponentLinkMap(id);
     lm->setAllowedPorts(&ci.ports);
@@ -261,12 +269,13 @@ Factory::GetComponentInfoStatisticUnits(const std::string& type, const std::stri
     boost::tie(elemlib, elem) = parseLoadName(compTypeToLoad);
 
     // ensure library is already loaded...
-    if (loaded_libraries.find(elemlib) == loaded_libraries.end()) {
-        findLibrary(elemlib);
-    }
+    requireLibrary(elemlib);
 
     // now look for component
     std::string tmp = elemlib + "." + elem;
+
+    std::lock_guard<std::recursive_mutex> lock(factoryMutex);
+
     eic_map_t::iterator eii = found_components.find(tmp);
     if (eii == found_components.end()) {
         out.fatal(CALL_INFO, -1,"can't find requested component %s.\n ", tmp.c_str());
@@ -297,15 +306,18 @@ Factory::CreateIntrospector(std::string &type,
     // now look for component
     std::string tmp = elemlib + "." + elem;
 
-    std::lock_guard<std::recursive_mutex> lock(factoryMutex);
+    const IntrospectorInfo* iinfo;
+    {
+        std::lock_guard<std::recursive_mutex> lock(factoryMutex);
 
-    eii_map_t::iterator eii = found_introspectors.find(tmp);
-    if (eii == found_introspectors.end()) {
-        out.fatal(CALL_INFO, -1,"can't find requested introspector %s.\n ", tmp.c_str());
-        return NULL;
+        eii_map_t::iterator eii = found_introspectors.find(tmp);
+        if (eii == found_introspectors.end()) {
+            out.fatal(CALL_INFO, -1,"can't find requested introspector %s.\n ", tmp.c_str());
+            return NULL;
+        }
+        iinfo = &eii->second;
     }
-
-    const IntrospectorInfo ii = eii->second;
+    const IntrospectorInfo& ii = *iinfo;
 
     params.pushAllowedKeys(ii.params);
     Introspector *ret = ii.introspector->alloc(params);
@@ -333,14 +345,17 @@ Factory::CreateModule(std::string type, Params& params)
         // now look for module
         std::string tmp = elemlib + "." + elem;
 
-        std::lock_guard<std::recursive_mutex> lock(factoryMutex);
-        eim_map_t::iterator eim = found_modules.find(tmp);
-        if (eim == found_modules.end()) {
-            out.fatal(CALL_INFO, -1, "can't find requested module %s.\n ", tmp.c_str());
-            return NULL;
+        const ModuleInfo* minfo;
+        {
+            std::lock_guard<std::recursive_mutex> lock(factoryMutex);
+            eim_map_t::iterator eim = found_modules.find(tmp);
+            if (eim == found_modules.end()) {
+                out.fatal(CALL_INFO, -1, "can't find requested module %s.\n ", tmp.c_str());
+                return NULL;
+            }
+            minfo = &eim->second;
         }
-
-        const ModuleInfo mi = eim->second;
+        const ModuleInfo& mi = *minfo;
 
         params.pushAllowedKeys(mi.params);
         Module *ret = mi.module->alloc(params);
@@ -426,15 +441,18 @@ Factory::CreateModuleWithComponent(std::string type, Component* comp, Params& pa
         // now look for module
         std::string tmp = elemlib + "." + elem;
 
-        std::lock_guard<std::recursive_mutex> lock(factoryMutex);
-
-        eim_map_t::iterator eim = found_modules.find(tmp);
-        if (eim == found_modules.end()) {
-            out.fatal(CALL_INFO, -1,"can't find requested module %s.\n ", tmp.c_str());
-            return NULL;
+        const ModuleInfo* minfo;
+        {
+            std::lock_guard<std::recursive_mutex> lock(factoryMutex);
+
+            eim_map_t::iterator eim = found_modules.find(tmp);
+            if (eim == found_modules.end()) {
+                out.fatal(CALL_INFO, -1,"can't find requested module %s.\n ", tmp.c_str());
+                return NULL;
+            }
+            minfo = &eim->second;
         }
-
-        const ModuleInfo mi = eim->second;
+        const ModuleInfo& mi = *minfo;
 
         params.pushAllowedKeys(mi.params);
         Module *ret = mi.module->alloc_with_comp(comp, params);
@@ -460,15 +478,18 @@ Factory::CreateSubComponent(std::string type, Component* comp, Params& params)
     // now look for module
     std::string tmp = elemlib + "." + elem;
 
-    std::lock_guard<std::recursive_mutex> lock(factoryMutex);
+    const SubComponentInfo* sinfo;
+    {
+        std::lock_guard<std::recursive_mutex> lock(factoryMutex);
 
-    eis_map_t::iterator eis = found_subcomponents.find(tmp);
-    if (eis == found_subcomponents.end()) {
-        out.fatal(CALL_INFO, -1,"can't find requested subcomponent %s.\n ", tmp.c_str());
-        return NULL;
+        eis_map_t::iterator eis = found_subcomponents.find(tmp);
+        if (eis == found_subcomponents.end()) {
+            out.fatal(CALL_INFO, -1,"can't find requested subcomponent %s.\n ", tmp.c_str());
+            return NULL;
+        }
+        sinfo = &eis->second;
     }
-
-    const SubComponentInfo si = eis->second;
+    const SubComponentInfo& si = *sinfo;
 
     params.pushAllowedKeys(si.params);
     SubComponent* ret = si.subcomponent->alloc(comp, params);
@@ -586,6 +607,7 @@ void Factory::requireLibrary(std::string &elemlib)
 
 void Factory::getLoadedLibraryNames(std::set<std::string>& lib_names)
 {
+    std::lock_guard<std::recursive_mutex> lock(factoryMutex);
     for ( eli_map_t::const_iterator i = loaded_libraries.begin();
           i != loaded_libraries.end(); ++i)
         {
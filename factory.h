@@ -358,7 +358,9 @@ private:
     eig_map_t found_generators;
     std::string searchPaths;
     ElemLoader *loader;
-    std::string loadingComponentType;
+    // Type of the component being built by this thread, for the
+    // statistic lookups done from its constructor
+    static thread_local std::string loadingComponentType;
 
     std::pair<std::string, std::string> parseLoadName(const std::string& wholename);
 
@@ -0,0 +1,95 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/fifoLinkQueue.h>
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+    FifoLinkQueue::FifoLinkQueue(TimeVortex* tv) :
+        ActivityQueue(),
+        tv(tv)
+    {}
+
+    FifoLinkQueue::FifoLinkQueue() :
+        ActivityQueue(),
+        tv(NULL)
+    {}
+
+    FifoLinkQueue::~FifoLinkQueue() {
+	// The head of the FIFO is owned by the TimeVortex, delete the
+	// rest
+	for ( size_t i = 1; i < data.size(); i++ ) {
+	    delete data[i];
+	}
+	data.clear();
+    }
+
+    bool FifoLinkQueue::empty()
+    {
+	return data.empty();
+    }
+
+    int FifoLinkQueue::size()
+    {
+	return data.size();
+    }
+
+    void FifoLinkQueue::insert(Activity* activity)
+    {
+	tv->assignQueueOrder(activity);
+	if ( data.empty() ) {
+	    data.push_back(activity);
+	    tv->insertOrdered(activity);
+	    return;
+	}
+
+	// All events on the link have the same link order and
+	// increasing queue order, so the event can go at the back if
+	// it is not before the tail in time and priority.
+	Activity* tail = data.back();
+	if ( activity->getDeliveryTime() > tail->getDeliveryTime() ||
+	     ( activity->getDeliveryTime() == tail->getDeliveryTime() &&
+	       activity->getPriority() >= tail->getPriority() ) ) {
+	    data.push_back(activity);
+	    tv->holdActivity();
+	}
+	else {
+	    tv->insertOrdered(activity);
+	}
+    }
+
+    Activity* FifoLinkQueue::pop()
+    {
+	if ( data.empty() ) return NULL;
+	Activity* ret_val = data.front();
+	data.pop_front();
+	if ( !data.empty() ) {
+	    tv->releaseActivity();
+	    tv->insertOrdered(data.front());
+	}
+	return ret_val;
+    }
+
+    Activity* FifoLinkQueue::front()
+    {
+	if ( data.empty() ) return NULL;
+	return data.front();
+    }
+
+
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::FifoLinkQueue)
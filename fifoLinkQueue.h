@@ -0,0 +1,72 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_FIFOLINKQUEUE_H
+#define SST_CORE_FIFOLINKQUEUE_H
+
+#include <sst/core/serialization.h>
+
+#include <deque>
+
+#include <sst/core/activityQueue.h>
+
+namespace SST {
+
+class TimeVortex;
+
+/**
+ * Receive queue for a handler Link that keeps the Link's pending
+ * events in a local FIFO.  Only the head of the FIFO is in the
+ * TimeVortex; the next event is moved into the TimeVortex when the
+ * head is delivered.  Events keep the queue order they were given
+ * when sent, so the delivery order is exactly the same as when every
+ * event is inserted directly into the TimeVortex.  Events that would
+ * be delivered before the tail of the FIFO (possible when sends use
+ * different extra delays) bypass the FIFO.  Events held in the FIFO
+ * are counted in the depth of the TimeVortex.
+ */
+class FifoLinkQueue : public ActivityQueue {
+public:
+    FifoLinkQueue(TimeVortex* tv);
+    FifoLinkQueue(); // Only used for serialization
+    ~FifoLinkQueue();
+
+    bool empty();
+    int size();
+    void insert(Activity* activity);
+    Activity* pop();
+    Activity* front();
+
+    /** Called before an event on the link is delivered.  If it is
+     * the head of the FIFO, the next event is moved into the
+     * TimeVortex. */
+    inline void delivered(Activity* activity) {
+        if ( !data.empty() && data.front() == activity ) pop();
+    }
+
+private:
+    TimeVortex* tv;
+    std::deque<Activity*> data;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ActivityQueue);
+    }
+};
+
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::FifoLinkQueue)
+
+#endif // SST_CORE_FIFOLINKQUEUE_H
@@ -27,7 +27,10 @@ namespace SST {
 SimulatorHeartbeat::SimulatorHeartbeat( Config* cfg, int this_rank, Simulation* sim, TimeConverter* period) :
     Action(),
     rank(this_rank),
-    m_period( period )
+    m_period( period ),
+    lastTime(0),
+    lastAllocs(0),
+    lastFrees(0)
 {
     sim->insertActivity( period->getFactor(), this );
     if( (0 == this_rank) ) {
@@ -49,6 +52,7 @@ void SimulatorHeartbeat::execute( void )
     const double now = sst_get_cpu_time();
 
     Output& sim_output = sim->getSimulationOutput();
+    const double elapsed = now - lastTime;
     if ( 0 == rank ) {
         sim->getSimulationOutput().output("# Simulation Heartbeat: Simulated Time %s (Real CPU time since last period %.5f seconds)\n",
                                           sim->getElapsedSimTime().toStringBestSI().c_str(), (now - lastTime) );
@@ -68,10 +72,13 @@ void SimulatorHeartbeat::execute( void )
 
     uint64_t mempool_size;
     uint64_t active_activities;
+    uint64_t mempool_allocs = 0, mempool_frees = 0, mempool_remote_frees = 0;
 #ifdef USE_MEMPOOL
     Activity::getMemPoolUsage(mempool_size, active_activities);
+    Activity::getMemPoolCounters(mempool_allocs, mempool_frees, mempool_remote_frees);
 #endif
     uint64_t max_mempool_size, global_mempool_size, global_active_activities;
+    uint64_t global_mempool_allocs, global_mempool_frees, global_mempool_remote_frees;
     
 #ifdef SST_CONFIG_HAVE_MPI
     MPI_Allreduce(&local_max_tv_depth, &global_max_tv_depth, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
@@ -80,6 +87,9 @@ void SimulatorHeartbeat::execute( void )
     MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
     MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
     MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&mempool_allocs, &global_mempool_allocs, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&mempool_frees, &global_mempool_frees, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce(&mempool_remote_frees, &global_mempool_remote_frees, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
 #else
     global_max_tv_depth = local_max_tv_depth;
     global_max_sync_data_size = 0;
@@ -87,6 +97,9 @@ void SimulatorHeartbeat::execute( void )
     max_mempool_size = mempool_size;
     global_mempool_size = mempool_size;
     global_active_activities = active_activities;
+    global_mempool_allocs = mempool_allocs;
+    global_mempool_frees = mempool_frees;
+    global_mempool_remote_frees = mempool_remote_frees;
 #endif
 
         
@@ -111,6 +124,14 @@ void SimulatorHeartbeat::execute( void )
                           global_mempool_size_ua.toStringBestSI().c_str());
         sim_output.output("\tGlobal active activities         %" PRIu64 " activities\n",
                           global_active_activities);
+        if ( elapsed > 0.0 ) {
+            sim_output.output("\tGlobal mempool allocs/frees:     %.0f / %.0f per second (%" PRIu64 " cross-thread frees)\n",
+                              (global_mempool_allocs - lastAllocs) / elapsed,
+                              (global_mempool_frees - lastFrees) / elapsed,
+                              global_mempool_remote_frees);
+        }
+        lastAllocs = global_mempool_allocs;
+        lastFrees = global_mempool_frees;
         sim_output.output("\tMax TimeVortex depth:            %" PRIu64 " entries\n",
                           global_max_tv_depth);
         sim_output.output("\tMax Sync data size:              %s\n",
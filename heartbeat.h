@@ -46,6 +46,8 @@ private:
     int rank;
     TimeConverter*  m_period;
     double lastTime;
+    uint64_t lastAllocs;
+    uint64_t lastFrees;
     
     friend class boost::serialization::access;
     template<class Archive>
@@ -14,6 +14,7 @@
 #include "sst/core/serialization.h"
 #include <sst/core/link.h>
 
+#include <chrono>
 #include <utility>
 
 #include <sst/core/event.h>
@@ -33,11 +34,15 @@ ActivityQueue* Link::uninitQueue = NULL;
 ActivityQueue* Link::afterInitQueue = NULL;
     
 Link::Link(LinkId_t id) :
+    fifoQueue( NULL ),
     rFunctor( NULL ),
     defaultTimeBase( NULL ),
     latency(1),
+    profileEvents(0),
+    profileTime(0.0),
     type(HANDLER),
-    id(id)
+    id(id),
+    sync_index(-1)
 {
     if ( uninitQueue == NULL )
 	uninitQueue = new UninitializedQueue("ERROR: Trying to send or recv from link during initialization.  Send and Recv cannot be called before setup.");
@@ -50,11 +55,15 @@ Link::Link(LinkId_t id) :
 }
 
 Link::Link() :
+    fifoQueue( NULL ),
     rFunctor( NULL ),
     defaultTimeBase( NULL ),
     latency(1),
+    profileEvents(0),
+    profileTime(0.0),
     type(HANDLER),
-    id(-1)
+    id(-1),
+    sync_index(-1)
 {
     if ( uninitQueue == NULL )
 	uninitQueue = new UninitializedQueue("ERROR: Trying to send or recv from link during initialization.  Send and Recv cannot be called before setup.");
@@ -70,6 +79,7 @@ Link::~Link() {
     if ( type == POLL && recvQueue != uninitQueue && recvQueue != afterInitQueue ) {
         delete recvQueue;
     }
+    if ( fifoQueue != NULL ) delete fifoQueue;
     if ( rFunctor != NULL ) delete rFunctor;
 }
 
@@ -77,6 +87,11 @@ void Link::finalizeConfiguration() {
     // TraceFunction trace (CALL_INFO_LONG);
     recvQueue = configuredQueue;
     configuredQueue = NULL;
+    Simulation* sim = Simulation::getSimulation();
+    if ( sim->linkFifo && type == HANDLER && recvQueue == sim->getTimeVortex() ) {
+        fifoQueue = new FifoLinkQueue(sim->getTimeVortex());
+        recvQueue = fifoQueue;
+    }
     if ( initQueue != NULL ) {
 	if ( dynamic_cast<InitQueue*>(initQueue) != NULL) {
 	    delete initQueue;
@@ -91,6 +106,13 @@ void Link::setPolling() {
     configuredQueue = new PollingLinkQueue();
 }
 
+void Link::deliverEventProfiled(Event* event) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    (*rFunctor)(event);
+    profileTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    profileEvents++;
+}
+
     
 void Link::setLatency(Cycle_t lat) {
     latency = lat;
@@ -119,6 +141,7 @@ void Link::send( SimTime_t delay, TimeConverter* tc, Event* event ) {
     }
     event->setDeliveryTime(cycle);
     event->setDeliveryLink(id,pair_link);
+    event->setSyncIndex(sync_index);
 
 #if __SST_DEBUG_EVENT_TRACKING__
     event->addSendComponent(comp, ctype, port);
@@ -153,12 +176,14 @@ void Link::sendInitData(Event* init_data)
     Simulation::getSimulation()->init_msg_count++;
     init_data->setDeliveryTime(Simulation::getSimulation()->init_phase + 1);
     init_data->setDeliveryLink(id,pair_link);
-    
-    pair_link->initQueue->insert(init_data);
+    init_data->setSyncIndex(sync_index);
 #if __SST_DEBUG_EVENT_TRACKING__
     init_data->addSendComponent(comp,ctype,port);
     init_data->addRecvComponent(pair_link->comp, pair_link->ctype, pair_link->port);
 #endif
+
+    // Remote init data is serialized on insert, so this must come last
+    pair_link->initQueue->insert(init_data);
 }
 
 void Link::sendInitData_sync(Event* init_data)
@@ -16,6 +16,7 @@
 #include <sst/core/serialization.h>
 
 #include <sst/core/event.h>
+#include <sst/core/fifoLinkQueue.h>
 // #include <sst/core/eventFunctor.h>
 
 namespace SST { 
@@ -42,6 +43,7 @@ public:
     friend class SyncBase;
     friend class ThreadSync;
     friend class SyncManager;
+    friend class ThreadLoadBalancer;
     
     /** Create a new link with a given ID */
     Link(LinkId_t id);
@@ -115,6 +117,22 @@ public:
         (*rFunctor)(event);
     }
 
+    /** Moves the next event on the link into the TimeVortex if event
+     * is the head of the link's FIFO queue.  Must be called before
+     * the event is delivered.  For use by SST Core only */
+    inline void advanceFifo(Event* event) {
+        if ( fifoQueue != NULL ) fifoQueue->delivered(event);
+    }
+
+    /** Delivers the event like deliverEvent(), counting it and timing
+     * the handler.  For use by SST Core only */
+    void deliverEventProfiled(Event* event);
+
+    /** Return the number of events delivered by deliverEventProfiled() */
+    uint64_t getProfileEvents() const { return profileEvents; }
+    /** Return the seconds spent in the handler by deliverEventProfiled() */
+    double getProfileTime() const { return profileTime; }
+
     /** Return the ID of this link */
     LinkId_t getId() { return id; }
 
@@ -151,6 +169,8 @@ protected:
     static ActivityQueue* uninitQueue;
     /** Unitialized queue.  Used for error detection */
     static ActivityQueue* afterInitQueue;
+    /** Per-link FIFO in front of the TimeVortex, NULL if not used */
+    FifoLinkQueue* fifoQueue;
 
     /** Recieve functor. This functor is set when the link is connected.
       Determines what the receiver wants to be called
@@ -173,6 +193,11 @@ protected:
     /** Pointer to the opposite side of this link */
     Link* pair_link;
 
+    /** Events delivered and seconds spent in their handler, when
+     * profiling */
+    uint64_t profileEvents;
+    double profileTime;
+
 private:
     Link( const Link& l );
 
@@ -181,6 +206,9 @@ private:
     
     Type_t type;
     LinkId_t id;
+    /** Index of the far end of the link in the table of the sync that
+     * delivers to it, when the link crosses threads or ranks */
+    LinkId_t sync_index;
 
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     std::string comp;
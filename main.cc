@@ -25,6 +25,8 @@
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <set>
+#include <sstream>
 #include <signal.h>
 
 #include <sst/core/activity.h>
@@ -36,6 +38,7 @@
 #include <sst/core/simulation.h>
 #include <sst/core/timeLord.h>
 #include <sst/core/timeVortex.h>
+#include <sst/core/part/profile.h>
 #include <sst/core/part/sstpart.h>
 #include <sst/core/statapi/statoutput.h>
 
@@ -44,6 +47,7 @@
 #include <sst/core/model/sstmodel.h>
 #include <sst/core/model/pymodel.h>
 #include <sst/core/memuse.h>
+#include <sst/core/threadPlacement.h>
 #include <sst/core/iouse.h>
 
 #include <sys/resource.h>
@@ -137,16 +141,130 @@ static void dump_partition(Config& cfg, ConfigGraph* graph, const RankInfo &size
             }
         }
 
+        // Cuts between ranks set the lookahead between ranks and cuts
+        // between the threads of a rank the inter-thread lookahead
+        ConfigLinkMap_t& link_map = graph->getLinkMap();
+        uint64_t rank_cuts = 0;
+        uint64_t thread_cuts = 0;
+        SimTime_t rank_latency = MAX_SIMTIME_T;
+        SimTime_t thread_latency = MAX_SIMTIME_T;
+        for (ConfigLinkMap_t::const_iterator j = link_map.begin() ; j != link_map.end() ; ++j) {
+            const RankInfo& r0 = component_map[j->component[0]].rank;
+            const RankInfo& r1 = component_map[j->component[1]].rank;
+            if ( r0.rank != r1.rank ) {
+                rank_cuts++;
+                rank_latency = std::min(rank_latency, j->getMinLatency());
+            }
+            else if ( r0.thread != r1.thread ) {
+                thread_cuts++;
+                thread_latency = std::min(thread_latency, j->getMinLatency());
+            }
+        }
+
+        graph_file << "Links cut between ranks:   " << rank_cuts << std::endl;
+        if ( rank_cuts > 0 ) {
+            graph_file << "   -> lookahead " << rank_latency << std::endl;
+        }
+        graph_file << "Links cut between threads: " << thread_cuts << std::endl;
+        if ( thread_cuts > 0 ) {
+            graph_file << "   -> lookahead " << thread_latency << std::endl;
+        }
+
         graph_file.close();
 
         if(cfg.verbose) {
+            g_output.verbose(CALL_INFO, 1, 0,
+                    "# Links cut between ranks: %" PRIu64 ", between threads: %" PRIu64 "\n",
+                    rank_cuts, thread_cuts);
             g_output.verbose(CALL_INFO, 2, 0,
                     "# Dump of partition graph is complete.\n");
         }
     }
 }
 
-static void do_graph_wireup(ConfigGraph* graph,
+// Find this rank's share of the cpus of its node for thread placement.
+// Ranks on a node that are allowed the same cpus (no binding by the MPI
+// launcher) split them between them.  Returns false if the ranks' cpus
+// only partly overlap, in which case nothing can be placed safely.
+static bool node_placement_slice(uint32_t& slice, uint32_t& num_slices) {
+    slice = 0;
+    num_slices = 1;
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int node_rank, node_size;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+
+    std::vector<int> mine = Core::getAllowedCPUs();
+    int count = mine.size();
+    std::vector<int> counts(node_size);
+    MPI_Allgather(&count, 1, MPI_INT, &counts[0], 1, MPI_INT, node_comm);
+    std::vector<int> offsets(node_size, 0);
+    for ( int i = 1; i < node_size; i++ ) offsets[i] = offsets[i - 1] + counts[i - 1];
+    std::vector<int> all(offsets[node_size - 1] + counts[node_size - 1] + 1);
+    MPI_Allgatherv(count ? &mine[0] : NULL, count, MPI_INT, &all[0], &counts[0], &offsets[0], MPI_INT, node_comm);
+    MPI_Comm_free(&node_comm);
+
+    std::set<int> my_cpus(mine.begin(), mine.end());
+    int same = 0;
+    for ( int r = 0; r < node_size; r++ ) {
+        if ( r == node_rank ) continue;
+        std::vector<int> theirs(all.begin() + offsets[r], all.begin() + offsets[r] + counts[r]);
+        if ( theirs == mine ) {
+            same++;
+            continue;
+        }
+        for ( size_t i = 0; i < theirs.size(); i++ ) {
+            if ( my_cpus.count(theirs[i]) ) return false;
+        }
+    }
+
+    // Only the ranks allowed exactly these cpus share them
+    if ( same > 0 ) {
+        for ( int r = 0; r < node_rank; r++ ) {
+            if ( std::vector<int>(all.begin() + offsets[r], all.begin() + offsets[r] + counts[r]) == mine ) slice++;
+        }
+        num_slices = same + 1;
+    }
+#endif
+    return true;
+}
+
+// Collect the profiles of all ranks on rank 0 and write them out
+static void write_profile(Config& cfg, PartitionProfile& profile, const RankInfo& myRank, const RankInfo& world_size) {
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( world_size.rank > 1 ) {
+        if ( myRank.rank == 0 ) {
+            for ( uint32_t r = 1; r < world_size.rank; r++ ) {
+                std::string text;
+                Comms::recv(r, 0, text);
+                std::istringstream is(text);
+                profile.read(is);
+            }
+        }
+        else {
+            std::ostringstream os;
+            profile.write(os);
+            std::string text = os.str();
+            Comms::send(0, 0, text);
+            return;
+        }
+    }
+#endif
+
+    ofstream profile_file(cfg.output_profile.c_str());
+    if ( !profile_file ) {
+        g_output.output("WARNING: Unable to write partition profile to %s\n", cfg.output_profile.c_str());
+        return;
+    }
+    profile.write(profile_file);
+    if ( cfg.verbose ) {
+        g_output.verbose(CALL_INFO, 1, 0, "# Wrote partition profile to %s\n", cfg.output_profile.c_str());
+    }
+}
+
+static void do_graph_wireup(ConfigGraph* graph, const ConfigGraphThreadIndex* index,
         SST::Simulation* sim, SST::Config* cfg, const RankInfo &world_size,
         const RankInfo &myRank, SimTime_t min_part) {
 
@@ -155,26 +273,29 @@ static void do_graph_wireup(ConfigGraph* graph,
                 myRank.rank, myRank.thread);
     }
 
+    // The threads wire up at the same time, so only one of them
+    // writes out the graph
     std::vector<ConfigGraphOutput*> graphOutputs;
+    if ( myRank.thread == 0 ) {
+        // User asked us to dump the config graph to a file in Python
+        if(cfg->output_config_graph != "") {
+            graphOutputs.push_back( new PythonConfigGraphOutput(cfg->output_config_graph.c_str()) );
+        }
 
-    // User asked us to dump the config graph to a file in Python
-    if(cfg->output_config_graph != "") {
-        graphOutputs.push_back( new PythonConfigGraphOutput(cfg->output_config_graph.c_str()) );
-    }
-
-    // user asked us to dump the config graph in dot graph format
-    if(cfg->output_dot != "") {
-        graphOutputs.push_back( new DotConfigGraphOutput(cfg->output_dot.c_str()) );
-    }
+        // user asked us to dump the config graph in dot graph format
+        if(cfg->output_dot != "") {
+            graphOutputs.push_back( new DotConfigGraphOutput(cfg->output_dot.c_str()) );
+        }
 
-    // User asked us to dump the config graph in XML format (for energy experiments)
-    if(cfg->output_xml != "") {
-        graphOutputs.push_back( new XMLConfigGraphOutput(cfg->output_xml.c_str()) );
-    }
+        // User asked us to dump the config graph in XML format (for energy experiments)
+        if(cfg->output_xml != "") {
+            graphOutputs.push_back( new XMLConfigGraphOutput(cfg->output_xml.c_str()) );
+        }
 
-    // User asked us to dump the config graph in JSON format (for OCCAM experiments)
-    if(cfg->output_json != "") {
-        graphOutputs.push_back( new JSONConfigGraphOutput(cfg->output_json.c_str()) );
+        // User asked us to dump the config graph in JSON format (for OCCAM experiments)
+        if(cfg->output_json != "") {
+            graphOutputs.push_back( new JSONConfigGraphOutput(cfg->output_json.c_str()) );
+        }
     }
 
     for(size_t i = 0; i < graphOutputs.size(); i++) {
@@ -182,7 +303,7 @@ static void do_graph_wireup(ConfigGraph* graph,
         delete graphOutputs[i];
     }
 
-    sim->performWireUp( *graph, myRank, min_part );
+    sim->performWireUp( *graph, *index, myRank, min_part );
 
 }
 
@@ -193,6 +314,7 @@ typedef struct {
     RankInfo world_size;
     Config *config;
     ConfigGraph *graph;
+    ConfigGraphThreadIndex *graph_index;
     SimTime_t min_part;
 
     // Time / stats information
@@ -202,6 +324,7 @@ typedef struct {
     uint64_t max_tv_depth;
     uint64_t current_tv_depth;
     uint64_t sync_data_size;
+    PartitionProfile profile;
 
 } SimThreadInfo_t;
 
@@ -209,6 +332,7 @@ typedef struct {
 static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSafe::Barrier &barrier)
 {
     info.myRank.thread = tid;
+    Core::ThreadSafe::Barrier::setThreadIndex(tid);
     double start_build = sst_get_cpu_time();
 
     if ( tid ) {
@@ -221,23 +345,20 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
 
     barrier.wait();
 
-    sim->processGraphInfo( *info.graph, info.myRank, info.min_part );
+    sim->processGraphInfo( *info.graph, *info.graph_index, info.myRank, info.min_part );
+
+    // Params objects should now start verifying parameters
+    if ( tid == 0 ) Params::enableVerify();
 
     barrier.wait();
     
-    // Perform the wireup.  Do this one thread at a time for now.  If
-    // this ever changes, then need to put in some serialization into
-    // performWireUp.
-    for ( uint32_t i = 0; i < info.world_size.thread; ++i ) {
-        if ( i == info.myRank.thread ) {
-            // g_output.output("wiring up this thread %u\n", info.myRank.thread);
-            do_graph_wireup(info.graph, sim, info.config, info.world_size, info.myRank, info.min_part);
-        }
-        barrier.wait();
-    }
+    // Perform the wireup.  All the threads do this at the same time,
+    // each on its own part of the graph.
+    do_graph_wireup(info.graph, info.graph_index, sim, info.config, info.world_size, info.myRank, info.min_part);
 
     barrier.wait();
     if ( tid == 0 ) {
+        delete info.graph_index;
         delete info.graph;
     }
 
@@ -348,6 +469,8 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
     info.current_tv_depth = sim->getTimeVortexCurrentDepth();
 //    info.sync_data_size = sim->getSyncQueueDataSize();
 
+    if ( info.config->output_profile != "" ) sim->collectProfile(info.profile);
+
     delete sim;
 
 }
@@ -380,6 +503,9 @@ main(int argc, char *argv[])
         return -1;
     }
     world_size.thread = cfg.getNumThreads();
+#ifdef USE_MEMPOOL
+    Core::MemPool::setUseHugePages(cfg.mempool_huge_pages);
+#endif
 
     SSTModelDescription* modelGen = 0;
 
@@ -426,9 +552,12 @@ main(int argc, char *argv[])
     double start_graph_gen = sst_get_cpu_time();
     graph = new ConfigGraph();
 
-    // Only rank 0 will populate the graph
-    if ( myRank.rank == 0 ) {
+    // Only rank 0 will populate the graph, unless every rank loads
+    // its own part of it
+    bool parallel_load = cfg.parallel_load && world_size.rank > 1;
+    if ( myRank.rank == 0 || parallel_load ) {
         if ( cfg.generator != "NONE" ) {
+            if ( parallel_load ) graph->setLoadRank(myRank.rank, world_size.rank);
             generateFunction func = factory->GetGenerator(cfg.generator);
             func(graph,cfg.generator_options, world_size.rank);
         } else {
@@ -446,7 +575,35 @@ main(int argc, char *argv[])
     // Need to initialize TimeLord before we use UnitAlgebra
     Simulation::getTimeLord()->init(cfg.timeBase);
 
-    if ( myRank.rank == 0 ) {
+    if ( parallel_load ) {
+        // Only the linear and self partitioners have a distributed
+        // version, and neither looks at weights
+        if ( cfg.partitioner != "linear" && cfg.partitioner != "self" ) {
+            g_output.fatal(CALL_INFO, 1, "ERROR: --parallel-load only supports the linear and self partitioners, not %s\n",
+                           cfg.partitioner.c_str());
+        }
+        if ( cfg.partition_profile != "" ) {
+            g_output.fatal(CALL_INFO, 1, "ERROR: --partition-profile can't be used with --parallel-load\n");
+        }
+#ifdef SST_CONFIG_HAVE_MPI
+        int weighted = 0;
+        ConfigComponentMap_t& comps = graph->getComponentMap();
+        for ( ConfigComponentMap_t::iterator iter = comps.begin(); iter != comps.end(); ++iter ) {
+            if ( iter->weight != 1.0f ) weighted = 1;
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &weighted, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if ( weighted && myRank.rank == 0 ) {
+            g_output.output("WARNING: Component weights are not used with --parallel-load, which only supports the linear and self partitioners\n");
+        }
+
+        // Also partitions the graph
+        graph->distributeParallelLoad(world_size, cfg.partitioner == "self");
+#endif
+        if ( graph->checkForStructuralErrors() ) {
+            g_output.fatal(CALL_INFO, -1, "Structure errors found in the ConfigGraph.\n");
+        }
+    }
+    else if ( myRank.rank == 0 ) {
         graph->postCreationCleanup();
 
         // Check config graph to see if there are structural errors.
@@ -473,6 +630,21 @@ main(int argc, char *argv[])
     ////// Start Partitioning //////
     double start_part = sst_get_cpu_time();
 
+    // Weights from an earlier run only matter where the partitioner
+    // runs
+    if ( cfg.partition_profile != "" && myRank.rank == 0 && !parallel_load ) {
+        ifstream profile_file(cfg.partition_profile.c_str());
+        PartitionProfile profile;
+        if ( !profile_file || !profile.read(profile_file) ) {
+            g_output.fatal(CALL_INFO, 1, "ERROR: Unable to read partition profile %s\n",
+                           cfg.partition_profile.c_str());
+        }
+        if ( profile.apply(graph, g_output) && cfg.verbose ) {
+            g_output.verbose(CALL_INFO, 1, 0, "# Partition weights taken from profile %s\n",
+                             cfg.partition_profile.c_str());
+        }
+    }
+
     // If this is a serial job, just use the single partitioner,
     // but the same code path
     if ( world_size.rank == 1 && world_size.thread == 1) cfg.partitioner = "single";
@@ -484,7 +656,10 @@ main(int argc, char *argv[])
         partitioner = func(world_size, myRank, cfg.verbose);
     }
 
-    if ( partitioner->requiresConfigGraph() ) {
+    if ( parallel_load ) {
+        // Already done
+    }
+    else if ( partitioner->requiresConfigGraph() ) {
         partitioner->performPartition(graph);
     }
     else {
@@ -508,7 +683,7 @@ main(int argc, char *argv[])
     delete partitioner;
 
     // Check the partitioning to make sure it is sane
-    if ( myRank.rank == 0 ) {
+    if ( myRank.rank == 0 || parallel_load ) {
         if ( !graph->checkRanks( world_size ) ) {
             g_output.fatal(CALL_INFO, 1,
                     "ERROR: Bad partitionning; partition included unknown ranks.\n");
@@ -524,8 +699,9 @@ main(int argc, char *argv[])
         g_output.verbose(CALL_INFO, 1, 0, "# ------------------------------------------------------------\n");
 
 
-        // Output the partition information is user requests it
-        dump_partition(cfg, graph, world_size);
+        // Output the partition information is user requests it.  No
+        // rank has the whole graph after a parallel load.
+        if ( !parallel_load ) dump_partition(cfg, graph, world_size);
     }
 
     ////// End Partitioning //////
@@ -534,7 +710,7 @@ main(int argc, char *argv[])
     SimTime_t min_part = 0xffffffffffffffffl;
     if ( world_size.rank > 1 ) {
         // Check the graph for the minimum latency crossing a partition boundary
-        if ( myRank.rank == 0 ) {
+        if ( myRank.rank == 0 || parallel_load ) {
             ConfigComponentMap_t comps = graph->getComponentMap();
             ConfigLinkMap_t links = graph->getLinkMap();
             // Find the minimum latency across a partition
@@ -563,7 +739,12 @@ main(int argc, char *argv[])
         // }
 
         // broadcast(world, min_part, 0);
-        Comms::broadcast(min_part, 0);
+        if ( parallel_load ) {
+            MPI_Allreduce(MPI_IN_PLACE, &min_part, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD);
+        }
+        else {
+            Comms::broadcast(min_part, 0);
+        }
 #endif
     }
     ////// End Calculate Minimum Partitioning //////
@@ -578,7 +759,7 @@ main(int argc, char *argv[])
 
     ////// Broadcast Graph //////
 #ifdef SST_CONFIG_HAVE_MPI
-    if ( world_size.rank > 1 ) {
+    if ( world_size.rank > 1 && !parallel_load ) {
         Comms::broadcast(Params::keyMap, 0);
         Comms::broadcast(Params::keyMapReverse, 0);
         Comms::broadcast(Params::nextKeyID, 0);
@@ -669,12 +850,20 @@ main(int argc, char *argv[])
     Simulation::factory = factory;
     Simulation::statisticsOutput = so;
     Simulation::sim_output = g_output;
+    // The load balancer uses the handler times too
+    Simulation::profiling = (cfg.output_profile != "" || (cfg.load_balance > 0.0 && world_size.thread > 1));
     Simulation::barrier.resize(world_size.thread);
+    Simulation::barrier.setHybrid(cfg.hybrid_barrier);
+    Simulation::barrier.setTree(cfg.tree_barrier);
+    Clock::setGroupHandlers(cfg.group_clock_handlers);
     #ifdef USE_MEMPOOL
     /* Estimate that we won't have more than 128 sizes of events */
     Activity::memPools.reserve(world_size.thread * 128);
     #endif
 
+    // Bucket this rank's part of the graph by thread for the wireup
+    ConfigGraphThreadIndex* graph_index = new ConfigGraphThreadIndex(*graph, myRank.rank, world_size.thread);
+
     std::vector<std::thread> threads(world_size.thread);
     std::vector<SimThreadInfo_t> threadInfo(world_size.thread);
     for ( uint32_t i = 0 ; i < world_size.thread ; i++ ) {
@@ -683,17 +872,55 @@ main(int argc, char *argv[])
         threadInfo[i].world_size = world_size;
         threadInfo[i].config = &cfg;
         threadInfo[i].graph = graph;
+        threadInfo[i].graph_index = graph_index;
         threadInfo[i].min_part = min_part;
     }
 
     double end_serial_build = sst_get_cpu_time();
 
+    // For NUMA placement, bind this thread to each simulation
+    // thread's cpu before creating it.  The new thread inherits the
+    // binding before it allocates anything, so its Simulation,
+    // TimeVortex, components and memory pools are all first touched
+    // on the local node.
+    std::vector<Core::ThreadPlacement> placement;
+    if ( cfg.numa_placement ) {
+        uint32_t slice, num_slices;
+        if ( node_placement_slice(slice, num_slices) ) {
+            placement = Core::computeThreadPlacement(world_size.thread, slice, num_slices);
+        }
+        else {
+            g_output.output("WARNING: rank %" PRIu32 " is allowed some of the same cpus as another rank on its node.  "
+                            "Threads are not bound.\n", myRank.rank);
+            Core::ThreadPlacement unbound = { -1, -1 };
+            placement.assign(world_size.thread, unbound);
+        }
+    }
+
     Output::setThreadID(std::this_thread::get_id(), 0);
     for ( uint32_t i = 1 ; i < world_size.thread ; i++ ) {
+        if ( cfg.numa_placement && !Core::bindThreadToCPU(placement[i].cpu) ) {
+            placement[i].cpu = -1;
+        }
         threads[i] = std::thread(start_simulation, i, std::ref(threadInfo[i]), std::ref(Simulation::barrier));
         Output::setThreadID(threads[i].get_id(), i);
     }
 
+    if ( cfg.numa_placement ) {
+        if ( !Core::bindThreadToCPU(placement[0].cpu) ) {
+            placement[0].cpu = -1;
+        }
+        for ( uint32_t i = 0 ; i < world_size.thread ; i++ ) {
+            if ( placement[i].cpu < 0 ) {
+                g_output.output("# Rank %" PRIu32 " thread %" PRIu32 ": not bound\n", myRank.rank, i);
+            }
+            else {
+                g_output.output("# Rank %" PRIu32 " thread %" PRIu32 ": cpu %d, NUMA node %d\n",
+                                myRank.rank, i, placement[i].cpu, placement[i].node);
+            }
+        }
+    }
+
 
     start_simulation(0, threadInfo[0], Simulation::barrier);
     for ( uint32_t i = 1 ; i < world_size.thread ; i++ ) {
@@ -704,6 +931,13 @@ main(int argc, char *argv[])
 
     double total_end_time = sst_get_cpu_time();
 
+    if ( cfg.output_profile != "" ) {
+        for ( uint32_t i = 1 ; i < world_size.thread ; i++ ) {
+            threadInfo[0].profile.merge(threadInfo[i].profile);
+        }
+        write_profile(cfg, threadInfo[0].profile, myRank, world_size);
+    }
+
     for ( uint32_t i = 1 ; i < world_size.thread ; i++ ) {
         // g_output.output(CALL_INFO,"simulated_time = %s, %s\n",threadInfo[0].simulated_time.toStringBestSI().c_str(),threadInfo[1].simulated_time.toStringBestSI().c_str());
         threadInfo[0].simulated_time = std::max(threadInfo[0].simulated_time, threadInfo[i].simulated_time);
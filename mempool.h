@@ -12,8 +12,10 @@
 #ifndef SST_CORE_MEMPOOL_H
 #define SST_CORE_MEMPOOL_H
 
+#include <atomic>
 #include <list>
-#include <deque>
+#include <thread>
+#include <vector>
 
 #include <cstddef>
 #include <cstdlib>
@@ -21,6 +23,7 @@
 #include <stdint.h>
 #include <sys/mman.h>
 
+#include "sst/core/sst_types.h"
 #include "sst/core/threadsafe.h"
 
 namespace SST {
@@ -28,62 +31,54 @@ namespace Core {
 
 /**
  * Simple Memory Pool class
+ *
+ * A pool is owned by the thread that creates it.  Only the owning
+ * thread allocates from the pool, so allocations and frees made by
+ * the owner use an unlocked free list.  Elements freed by other
+ * threads (e.g. events sent across a ThreadSync) are pushed onto a
+ * lock-free list, which the owner takes over in one step when its own
+ * free list runs dry.
+ *
+ * Arenas are not initialized up front.  Elements that have never been
+ * used are handed out from a bump pointer into the newest arena, so
+ * pages are only touched (and committed) when they are first needed,
+ * and the free list only ever holds returned elements.
  */
-class MemPool
+class MemPool : public ThreadSafe::CacheAlignedNew
 {
-    template <typename LOCK_t>
-    class FreeList {
-        LOCK_t mtx;
-        std::vector<void*> list;
-    public:
-        inline void insert(void *ptr) {
-            std::lock_guard<LOCK_t> lock(mtx);
-            list.push_back(ptr);
-        }
-
-        inline void* try_remove() {
-            std::lock_guard<LOCK_t> lock(mtx);
-            if ( list.empty() ) return NULL;
-            void *p = list.back();
-            list.pop_back();
-            return p;
-        }
-
-        size_t size() const { return list.size(); }
-    };
-
-
 public:
     /** Create a new Memory Pool.
      * @param elementSize - Size of each Element
      * @param initialSize - Size of the memory pool (in bytes)
      */
 	MemPool(size_t elementSize, size_t initialSize=(2<<20)) :
-        numAlloc(0), numFree(0),
+        numAlloc(0), numFree(0), numRemoteFree(0),
         elemSize(elementSize), arenaSize(initialSize),
-        allocating(false)
+        owner(std::this_thread::get_id()),
+        cursor(NULL), cursorEnd(NULL),
+        remoteList(NULL)
     {
-        allocPool();
+        // The first arena is mapped on the first allocation
     }
 
 	~MemPool()
     {
         for ( std::list<uint8_t*>::iterator i = arenas.begin() ; i != arenas.end() ; ++i ) {
-            ::free(*i);
+            munmap(*i, arenaSize);
         }
     }
 
-    /** Allocate a new element from the memory pool */
+    /** Allocate a new element from the memory pool.  Must only be
+     * called by the thread that owns the pool. */
 	inline void* malloc()
     {
-        void *ret = freeList.try_remove();
-        while ( !ret ) {
-            bool ok = allocPool();
-            if ( !ok ) return NULL;
-            _mm_pause();
-            ret = freeList.try_remove();
+        if ( UNLIKELY(freeList.empty()) ) {
+            takeRemoteFrees();
+            if ( freeList.empty() ) return bumpAlloc();
         }
-        ++numAlloc;
+        void* ret = freeList.back();
+        freeList.pop_back();
+        bump(numAlloc);
         return ret;
     }
 
@@ -91,11 +86,16 @@ public:
 	inline void free(void *ptr)
     {
         // TODO:  Make sure this is in one of our arenas
-        freeList.insert(ptr);
+        if ( LIKELY(std::this_thread::get_id() == owner) ) {
+            freeList.push_back(ptr);
+            bump(numFree);
+        }
+        else {
+            freeRemote(ptr);
+        }
 // #ifdef __SST_DEBUG_EVENT_TRACKING__
 //         *((uint64_t*)ptr) = 0xFFFFFFFFFFFFFFFF;
 // #endif
-        ++numFree;
     }
 
     /**
@@ -104,60 +104,127 @@ public:
      */
     uint64_t getBytesMemUsed() {
         uint64_t bytes_in_arenas = arenas.size() * arenaSize;
-        uint64_t bytes_in_free_list = freeList.size() * sizeof(void*);
+        uint64_t bytes_in_free_list = freeList.capacity() * sizeof(void*);
         return bytes_in_arenas + bytes_in_free_list;
     }
 
     uint64_t getUndeletedEntries() {
-        return numAlloc - numFree;
+        return numAlloc - numFree - numRemoteFree;
     }
-    
+
     /** Counter:  Number of times elements have been allocated */
     std::atomic<uint64_t> numAlloc;
-    /** Counter:  Number times elements have been freed */
+    /** Counter:  Number times elements have been freed by the owning thread */
     std::atomic<uint64_t> numFree;
+    /** Counter:  Number times elements have been freed by other threads */
+    std::atomic<uint64_t> numRemoteFree;
 
     size_t getArenaSize() const { return arenaSize; }
     size_t getElementSize() const { return elemSize; }
 
     const std::list<uint8_t*>& getArenas() { return arenas; }
-    
+
+    /** Number of elements at the start of arena that have been handed
+     * out at least once.  Elements past this have never been used. */
+    size_t getElementsUsed(const uint8_t* arena) const {
+        if ( arena == arenas.back() ) return (cursor - arena) / elemSize;
+        return arenaSize / elemSize;
+    }
+
+    /** Back new arenas with huge pages.  MAP_HUGETLB is tried first,
+     * falling back to madvise(MADV_HUGEPAGE) on a normal mapping.
+     * Only affects arenas allocated after the call. */
+    static void setUseHugePages(bool use) { useHugePages() = use; }
+
 private:
 
-	bool allocPool()
+    /* Counters are only written by one thread (the owner), so there
+     * is no need for a locked increment.  They are atomic so they can
+     * be read from other threads. */
+    static inline void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /* The first word of a free element is used by Activity for
+     * tracking, so the remote list is linked through the second. */
+    static inline void*& remoteNext(void* ptr) {
+        return ((void**)ptr)[1];
+    }
+
+    void freeRemote(void* ptr)
     {
-        /* If already in progress, return */
-        if ( allocating.exchange(1, std::memory_order_acquire) ) {
-            return true;
+        void* head = remoteList.load(std::memory_order_relaxed);
+        do {
+            remoteNext(ptr) = head;
+        } while ( !remoteList.compare_exchange_weak(head, ptr,
+                      std::memory_order_release,
+                      std::memory_order_relaxed) );
+        numRemoteFree.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void takeRemoteFrees()
+    {
+        if ( remoteList.load(std::memory_order_relaxed) == NULL ) return;
+        void* ptr = remoteList.exchange(NULL, std::memory_order_acquire);
+        while ( ptr != NULL ) {
+            void* next = remoteNext(ptr);
+            freeList.push_back(ptr);
+            ptr = next;
         }
+    }
+
+    static bool& useHugePages() {
+        static bool use = false;
+        return use;
+    }
+
+    void* bumpAlloc()
+    {
+        if ( cursor == cursorEnd && !allocPool() ) return NULL;
+        void* ret = cursor;
+        cursor += elemSize;
+        bump(numAlloc);
+        return ret;
+    }
 
-        uint8_t *newPool = (uint8_t*)mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+	bool allocPool()
+    {
+        uint8_t *newPool = (uint8_t*)MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if ( useHugePages() && (arenaSize % (2<<20)) == 0 ) {
+            newPool = (uint8_t*)mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_HUGETLB, -1, 0);
+        }
+#endif
         if ( MAP_FAILED == newPool ) {
-            allocating.store(0, std::memory_order_release);
-            return false;
+            newPool = (uint8_t*)mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+            if ( MAP_FAILED == newPool ) {
+                return false;
+            }
+#ifdef MADV_HUGEPAGE
+            if ( useHugePages() ) madvise(newPool, arenaSize, MADV_HUGEPAGE);
+#endif
         }
-        std::memset(newPool, 0xFF, arenaSize); 
+        // Fresh anonymous memory is zero, so the tracking word of every
+        // element is already NULL.
         arenas.push_back(newPool);
-        size_t nelem = arenaSize / elemSize;
-        for ( size_t i = 0 ; i < nelem ; i++ ) {
-            uint64_t* ptr = (uint64_t*)(newPool + (elemSize*i));
-// #ifdef __SST_DEBUG_EVENT_TRACKING__
-//             *ptr = 0xFFFFFFFFFFFFFFFF;
-// #endif
-            freeList.insert(ptr);
-            // freeList.push_back(newPool + (elemSize*i));
-        }
-        allocating.store(0, std::memory_order_release);
+        cursor = newPool;
+        cursorEnd = newPool + (arenaSize / elemSize) * elemSize;
         return true;
     }
 
 	size_t elemSize;
 	size_t arenaSize;
 
-    std::atomic<unsigned int> allocating;
-	FreeList<ThreadSafe::Spinlock> freeList;
+    std::thread::id owner;
+	std::vector<void*> freeList;
 	std::list<uint8_t*> arenas;
+    /* Next never-used element in the newest arena */
+    uint8_t* cursor;
+    uint8_t* cursorEnd;
 
+    /* Elements freed by other threads.  Kept on its own cache line so
+     * remote frees do not contend with the owner's state. */
+    alignas(64) std::atomic<void*> remoteList;
 };
 
 }
@@ -59,6 +59,7 @@ static void compDealloc(ComponentPy_t *self);
 static PyObject* compAddParam(PyObject *self, PyObject *args);
 static PyObject* compAddParams(PyObject *self, PyObject *args);
 static PyObject* compSetRank(PyObject *self, PyObject *arg);
+static PyObject* compIsLocal(PyObject *self, PyObject *args);
 static PyObject* compSetWeight(PyObject *self, PyObject *arg);
 static PyObject* compAddLink(PyObject *self, PyObject *args);
 static PyObject* compGetFullName(PyObject *self, PyObject *args);
@@ -96,6 +97,9 @@ static PyMethodDef componentMethods[] = {
     {   "setWeight",
         compSetWeight, METH_O,
         "Sets the weight of the component"},
+    {   "isLocal",
+        compIsLocal, METH_NOARGS,
+        "Returns whether this rank keeps the component when every rank loads the model (--parallel-load).  Calls on other components are ignored."},
     {   "addLink",
         compAddLink, METH_VARARGS,
         "Connects this component to a Link"},
@@ -347,6 +351,13 @@ static PyObject* compSetRank(PyObject *self, PyObject *args)
 }
 
 
+static PyObject* compIsLocal(PyObject *self, PyObject *args)
+{
+    ComponentId_t id = ((ComponentPy_t*)self)->id;
+    return PyBool_FromLong(gModel->isComponentLocal(id) ? 1 : 0);
+}
+
+
 static PyObject* compSetWeight(PyObject *self, PyObject *arg)
 {
     ComponentId_t id = ((ComponentPy_t*)self)->id;
@@ -725,6 +736,14 @@ static PyObject* getSSTMPIWorldSize(PyObject* self, PyObject* args) {
     return PyInt_FromLong(ranks);
 }
 
+static PyObject* getSSTMyMPIRank(PyObject* self, PyObject* args) {
+    int rank = 0;
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    return PyInt_FromLong(rank);
+}
+
 static PyObject* setStatisticOutput(PyObject* self, PyObject* args)
 {
     char*      statOutputName; 
@@ -962,6 +981,9 @@ static PyMethodDef sstModuleMethods[] = {
     {   "getMPIRankCount",
 	getSSTMPIWorldSize, METH_NOARGS,
 	"Gets the number of MPI ranks currently being used to run SST" }, 
+    {   "getMyMPIRank",
+        getSSTMyMPIRank, METH_NOARGS,
+        "Gets the MPI rank running this copy of the script" },
     {   "setStatisticOutput",
         setStatisticOutput, METH_VARARGS,
         "Sets the Statistic Output - default is console output." },
@@ -1005,6 +1027,15 @@ void SSTPythonModelDefinition::initModel(const std::string script_file, int verb
     gModel = this;
 
     graph = new ConfigGraph();
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( config->parallel_load ) {
+        int rank = 0;
+        int ranks = 1;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+        graph->setLoadRank(rank, ranks);
+    }
+#endif
 
     std::string local_script_name;
     int substr_index = 0;
@@ -70,6 +70,7 @@ class SSTPythonModelDefinition : public SSTModelDescription {
 
         void setComponentRank(ComponentId_t id, uint32_t rank, uint32_t thread) const { graph->setComponentRank(id, RankInfo(rank, thread)); }
         void setComponentWeight(ComponentId_t id, float weight) const { graph->setComponentWeight(id, weight); }
+        bool isComponentLocal(ComponentId_t id) const { return graph->isLoadLocal(id); }
         void addLink(ComponentId_t id, const char *name, const char *port, const char *latency, bool no_cut) const {graph->addLink(id, name, port, latency, no_cut); }
 
         void pushNamePrefix(const char *name);
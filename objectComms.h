@@ -216,6 +216,47 @@ void all_gather(const dataType& data, std::vector<dataType> &out_data) {
 }
 
 
+template <typename dataType>
+void all_to_all(const std::vector<dataType> &data, std::vector<dataType> &out_data) {
+    int world = 0;
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+
+    // Serialize the data for each rank into one buffer
+    std::vector<char> buffer;
+    std::vector<int> sendSizes(world);
+    std::vector<int> sendDispl(world);
+    for ( int i = 0 ; i < world ; i++ ) {
+        std::vector<char> part = Comms::serialize(data[i]);
+        sendDispl[i] = buffer.size();
+        sendSizes[i] = part.size();
+        buffer.insert(buffer.end(), part.begin(), part.end());
+    }
+
+    std::vector<int> recvSizes(world);
+    std::vector<int> recvDispl(world);
+    MPI_Alltoall(sendSizes.data(), 1, MPI_INT,
+            recvSizes.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+    int totalBuf = 0;
+    for ( int i = 0 ; i < world ; i++ ) {
+        recvDispl[i] = totalBuf;
+        totalBuf += recvSizes[i];
+    }
+
+    char *bigBuff = new char[totalBuf];
+
+    MPI_Alltoallv(buffer.data(), sendSizes.data(), sendDispl.data(), MPI_BYTE,
+            bigBuff, recvSizes.data(), recvDispl.data(), MPI_BYTE, MPI_COMM_WORLD);
+
+    out_data.resize(world);
+    for ( int i = 0 ; i < world ; i++ ) {
+        Comms::deserialize(&bigBuff[recvDispl[i]], recvSizes[i], out_data[i]);
+    }
+
+    delete [] bigBuff;
+}
+
+
 
 
 #endif
@@ -22,7 +22,8 @@ namespace SST {
 OneShot::OneShot(TimeConverter* timeDelay, int priority) :
     Action(),
     m_timeDelay(timeDelay),
-    m_scheduled(false)
+    m_scheduled(false),
+    m_hasCheckpoint(false)
 {
     setPriority(priority);
 } 
@@ -142,6 +143,39 @@ void OneShot::execute(void)
     m_scheduled = false;
 }
 
+void OneShot::clearHandlerLists()
+{
+    for (HandlerVectorMap_t::iterator m_it = m_HandlerVectorMap.begin(); m_it != m_HandlerVectorMap.end(); ++m_it ) {
+        delete m_it->second;
+    }
+    m_HandlerVectorMap.clear();
+}
+
+void OneShot::saveCheckpoint()
+{
+    m_savedHandlers.clear();
+    for (HandlerVectorMap_t::iterator m_it = m_HandlerVectorMap.begin(); m_it != m_HandlerVectorMap.end(); ++m_it ) {
+        m_savedHandlers[m_it->first] = *(m_it->second);
+    }
+    m_savedScheduled = m_scheduled;
+    m_hasCheckpoint = true;
+}
+
+void OneShot::restoreCheckpoint()
+{
+    // The handlers themselves are never deleted while the OneShot
+    // exists, so only the lists need to be rebuilt
+    clearHandlerLists();
+    if ( !m_hasCheckpoint ) {
+        m_scheduled = false;
+        return;
+    }
+    for (std::map<SimTime_t, HandlerList_t>::iterator m_it = m_savedHandlers.begin(); m_it != m_savedHandlers.end(); ++m_it ) {
+        m_HandlerVectorMap[m_it->first] = new HandlerList_t(m_it->second);
+    }
+    m_scheduled = m_savedScheduled;
+}
+
 void OneShot::print(const std::string& header, Output &out) const
 {
     out.output("%s OneShot Activity with time delay of %" PRIu64 " to be delivered at %" PRIu64
@@ -16,6 +16,9 @@
 #include <sst/core/sst_types.h>
 #include <sst/core/serialization.h>
 
+#include <map>
+#include <vector>
+
 #include <sst/core/action.h>
 
 #define _ONESHOT_DBG(fmt, args...)__DBG(DBG_ONESHOT, OneShot, fmt, ## args)
@@ -125,10 +128,21 @@ public:
 
     /** Print details about the OneShot */
     void print(const std::string& header, Output &out) const;
+
+    /** Save the state of the OneShot for optimistic execution (see
+     * Simulation::saveCheckpoint()) */
+    void saveCheckpoint();
+    /** Go back to the state saved by saveCheckpoint().  A OneShot with
+     * no saved state was created after the checkpoint, so it is left
+     * with no handlers and unscheduled. */
+    void restoreCheckpoint();
     
 private:
     typedef std::vector<OneShot::HandlerBase*>  HandlerList_t;
     typedef std::map<SimTime_t, HandlerList_t*> HandlerVectorMap_t;
+
+    /** Delete the handler lists (but not the handlers) */
+    void clearHandlerLists();
     
     // Generic constructor for serialization
     OneShot() { }
@@ -143,6 +157,10 @@ private:
     TimeConverter*      m_timeDelay;
     HandlerVectorMap_t  m_HandlerVectorMap;
     bool                m_scheduled;
+
+    std::map<SimTime_t, HandlerList_t> m_savedHandlers;
+    bool                m_savedScheduled;
+    bool                m_hasCheckpoint;
     
     friend class boost::serialization::access;
     template<class Archive>
@@ -20,6 +20,7 @@
 // System Headers
 #include <errno.h>
 #include <execinfo.h>
+#include <mutex>
 
 // Core Headers
 #include "sst/core/simulation.h"
@@ -41,6 +42,10 @@ std::unordered_map<std::thread::id, uint32_t> Output::m_threadMap;
 RankInfo Output::m_worldSize;
 int Output::m_mpiRank = 0;
 
+// Output objects are created on all the threads during wireup, and
+// share the file handles and access counts
+static std::mutex fileMutex;
+
 
 Output::Output(const std::string& prefix, uint32_t verbose_level,   
                uint32_t verbose_mask,output_location_t location, 
@@ -262,7 +267,10 @@ void Output::setTargetOutput(output_location_t location)
             m_targetFileAccessCountRef = &m_sstLocalFileAccessCount;
         }
         // Increment the Access count for the target output file 
-        (*m_targetFileAccessCountRef)++;
+        {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            (*m_targetFileAccessCountRef)++;
+        }
         break;
     case STDERR:
         m_targetOutputRef = &stderr;
@@ -285,6 +293,7 @@ void Output::openSSTTargetFile() const
     if (true == m_objInitialized) {
         // If the target output is a file, See if the output file is created and opened
         if ((FILE == m_targetLoc) && (0 == *m_targetFileHandleRef)) {
+            std::lock_guard<std::mutex> lock(fileMutex);
   
             // Check to see if the File has not been opened.
             if ((*m_targetFileAccessCountRef > 0) && (0 == *m_targetFileHandleRef)) {
@@ -314,6 +323,8 @@ void Output::openSSTTargetFile() const
 void Output::closeSSTTargetFile()
 {
     if ((true == m_objInitialized) && (FILE == m_targetLoc)) {
+        std::lock_guard<std::mutex> lock(fileMutex);
+
         // Decrement the Access count for the file
         if (*m_targetFileAccessCountRef > 0) {
             (*m_targetFileAccessCountRef)--; 
@@ -485,6 +485,9 @@ private:
 
     /* Friend main() because it broadcasts the maps */
     friend int ::main(int argc, char *argv[]);
+    /* Friend ConfigGraph because it merges the maps of ranks that
+     * loaded the model in parallel */
+    friend class ConfigGraph;
 
     static std::map<std::string, uint32_t> keyMap;
     static std::vector<std::string> keyMapReverse;
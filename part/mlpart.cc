@@ -0,0 +1,565 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/part/mlpart.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+namespace SST {
+namespace Partition {
+
+bool SSTMultilevelPartition::initialized = SSTPartitioner::addPartitioner("multilevel",&SSTMultilevelPartition::allocate, "Multilevel partitioner which balances component weights while keeping low latency links from being cut, so the lookahead between ranks and threads stays high.");
+bool SSTMultilevelPartition::initialized_hierarchical = SSTPartitioner::addPartitioner("hierarchical",&SSTMultilevelPartition::allocateHierarchical, "Multilevel partitioner which splits the ranks first, keeping the lookahead between ranks as high as it can, and then splits each rank among its threads.");
+
+namespace {
+
+/* The graph at one level of coarsening, in compressed sparse row form */
+struct Level {
+    std::vector<uint64_t> xadj;     // edges of vertex v are [xadj[v], xadj[v+1])
+    std::vector<uint32_t> adjncy;
+    std::vector<int64_t>  adjwgt;
+    std::vector<double>   vwgt;
+    std::vector<uint32_t> cmap;     // vertex in the next coarser level
+
+    uint32_t size() const { return vwgt.size(); }
+};
+
+const uint32_t UNMATCHED = 0xffffffff;
+
+/* Coarsening stops at this many vertices per part */
+const uint32_t COARSEN_PER_PART = 20;
+/* or when a level is no more than this much smaller than the last */
+const double COARSEN_MIN_SHRINK = 0.95;
+/* Largest group of low latency components kept together, as a share
+ * of a part */
+const double MAX_GROUP_SHARE = 0.1;
+/* Allowed imbalance of the part weights */
+const double IMBALANCE = 1.03;
+const int REFINE_PASSES = 8;
+
+}
+
+// Each step down in latency weighs 16 times the step above it, so a
+// lower latency link is only cut if that saves many higher latency
+// ones.  Capped so that sums of weights can't overflow.
+static int64_t
+latencyWeight(size_t num_latencies, size_t index)
+{
+    size_t steps = num_latencies - 1 - index;
+    if ( steps > 8 ) steps = 8;
+    return (int64_t)1 << (4 * steps);
+}
+
+static uint32_t
+vertexOf(const std::vector<ComponentId_t>& ids, bool dense, ComponentId_t id)
+{
+    if ( dense ) return id;
+    return std::lower_bound(ids.begin(), ids.end(), id) - ids.begin();
+}
+
+// Vertices are numbered in component id order.  Along with the graph,
+// returns the index of each edge's latency among the distinct link
+// latencies, lowest first.
+static size_t
+buildGraph(PartitionGraph* graph, Level& g, std::vector<ComponentId_t>& ids, bool& dense,
+           std::vector<uint8_t>& latency_index)
+{
+    PartitionComponentMap_t& comps = graph->getComponentMap();
+    PartitionLinkMap_t& links = graph->getLinkMap();
+
+    ids.reserve(comps.size());
+    g.vwgt.reserve(comps.size());
+    for ( PartitionComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
+        ids.push_back(it->id);
+        g.vwgt.push_back(it->weight);
+    }
+    // Collapsed graphs number the components from 0
+    dense = ids.empty() || ids.back() == ids.size() - 1;
+
+    std::set<SimTime_t> latency_set;
+    uint64_t max_events = 0;
+    for ( PartitionLinkMap_t::iterator it = links.begin(); it != links.end(); ++it ) {
+        latency_set.insert(it->getMinLatency());
+        max_events = std::max(max_events, it->event_count);
+    }
+    std::vector<SimTime_t> latencies(latency_set.begin(), latency_set.end());
+    // Anything past the 256th latency counts as the highest
+    size_t num_latencies = std::min(latencies.size(), (size_t)256);
+
+    uint32_t n = g.size();
+    g.xadj.assign(n + 1, 0);
+    for ( PartitionLinkMap_t::iterator it = links.begin(); it != links.end(); ++it ) {
+        uint32_t a = vertexOf(ids, dense, it->component[0]);
+        uint32_t b = vertexOf(ids, dense, it->component[1]);
+        if ( a == b ) continue;
+        g.xadj[a + 1]++;
+        g.xadj[b + 1]++;
+    }
+    for ( uint32_t v = 0; v < n; v++ ) {
+        g.xadj[v + 1] += g.xadj[v];
+    }
+
+    g.adjncy.resize(g.xadj[n]);
+    g.adjwgt.resize(g.xadj[n]);
+    latency_index.resize(g.xadj[n]);
+    std::vector<uint64_t> fill(g.xadj.begin(), g.xadj.end() - 1);
+    for ( PartitionLinkMap_t::iterator it = links.begin(); it != links.end(); ++it ) {
+        uint32_t a = vertexOf(ids, dense, it->component[0]);
+        uint32_t b = vertexOf(ids, dense, it->component[1]);
+        if ( a == b ) continue;
+        size_t index = std::lower_bound(latencies.begin(), latencies.end(), it->getMinLatency()) - latencies.begin();
+        if ( index >= num_latencies ) index = num_latencies - 1;
+        int64_t w = latencyWeight(num_latencies, index);
+        // With a profile, busier links weigh up to 4 times more, which
+        // is still less than a step in latency
+        if ( max_events > 0 ) w += w * (int64_t)(3.0 * it->event_count / max_events + 0.5);
+        latency_index[fill[a]] = index;
+        g.adjncy[fill[a]] = b;
+        g.adjwgt[fill[a]++] = w;
+        latency_index[fill[b]] = index;
+        g.adjncy[fill[b]] = a;
+        g.adjwgt[fill[b]++] = w;
+    }
+    return num_latencies;
+}
+
+static uint32_t
+findRoot(std::vector<uint32_t>& parent, uint32_t v)
+{
+    while ( parent[v] != v ) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+// Join the components connected by the lowest latency links, one
+// latency at a time, as long as no group gets heavier than
+// max_group.  None of these links are cut, so the lowest latency left
+// to cut is as high as it can be.  Sets g.cmap to the groups and
+// returns their number and the number of latencies joined.
+static uint32_t
+groupLowLatency(Level& g, const std::vector<uint8_t>& latency_index, size_t num_latencies,
+                double max_group, size_t& joined)
+{
+    uint32_t n = g.size();
+
+    std::vector<uint32_t> parent(n);
+    for ( uint32_t v = 0; v < n; v++ ) parent[v] = v;
+    std::vector<double> wgt(g.vwgt);
+    std::vector<uint32_t> saved_parent;
+    std::vector<double> saved_wgt;
+
+    joined = 0;
+    for ( size_t l = 0; l < num_latencies; l++ ) {
+        saved_parent = parent;
+        saved_wgt = wgt;
+        bool fits = true;
+        for ( uint32_t v = 0; v < n && fits; v++ ) {
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v + 1]; e++ ) {
+                if ( latency_index[e] != l || g.adjncy[e] < v ) continue;
+                uint32_t a = findRoot(parent, v);
+                uint32_t b = findRoot(parent, g.adjncy[e]);
+                if ( a == b ) continue;
+                parent[b] = a;
+                wgt[a] += wgt[b];
+                if ( wgt[a] > max_group ) {
+                    fits = false;
+                    break;
+                }
+            }
+        }
+        if ( !fits ) {
+            parent.swap(saved_parent);
+            break;
+        }
+        joined++;
+    }
+
+    g.cmap.assign(n, UNMATCHED);
+    std::vector<uint32_t> group(n, UNMATCHED);
+    uint32_t nc = 0;
+    for ( uint32_t v = 0; v < n; v++ ) {
+        uint32_t root = findRoot(parent, v);
+        if ( group[root] == UNMATCHED ) group[root] = nc++;
+        g.cmap[v] = group[root];
+    }
+    return nc;
+}
+
+// Pair each vertex with the unmatched neighbor it has the heaviest
+// edge to.  Sets g.cmap to the pairs and returns their number.
+static uint32_t
+match(Level& g, double max_vwgt)
+{
+    uint32_t n = g.size();
+
+    std::vector<uint32_t> match(n, UNMATCHED);
+    for ( uint32_t v = 0; v < n; v++ ) {
+        if ( match[v] != UNMATCHED ) continue;
+        uint32_t best = v;
+        int64_t best_wgt = 0;
+        for ( uint64_t e = g.xadj[v]; e < g.xadj[v + 1]; e++ ) {
+            uint32_t u = g.adjncy[e];
+            if ( match[u] != UNMATCHED || g.adjwgt[e] <= best_wgt ) continue;
+            if ( g.vwgt[v] + g.vwgt[u] > max_vwgt ) continue;
+            best = u;
+            best_wgt = g.adjwgt[e];
+        }
+        match[v] = best;
+        match[best] = v;
+    }
+
+    g.cmap.assign(n, UNMATCHED);
+    uint32_t nc = 0;
+    for ( uint32_t v = 0; v < n; v++ ) {
+        if ( g.cmap[v] != UNMATCHED ) continue;
+        g.cmap[v] = nc;
+        g.cmap[match[v]] = nc;
+        nc++;
+    }
+    return nc;
+}
+
+// Build the graph of the vertices merged by g.cmap
+static void
+contract(const Level& g, uint32_t nc, Level& coarse)
+{
+    uint32_t n = g.size();
+
+    coarse.vwgt.assign(nc, 0.0);
+    std::vector<uint32_t> first(nc + 1, 0);
+    for ( uint32_t v = 0; v < n; v++ ) {
+        coarse.vwgt[g.cmap[v]] += g.vwgt[v];
+        first[g.cmap[v] + 1]++;
+    }
+    for ( uint32_t c = 0; c < nc; c++ ) first[c + 1] += first[c];
+    std::vector<uint32_t> members(n);
+    std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+    for ( uint32_t v = 0; v < n; v++ ) members[fill[g.cmap[v]]++] = v;
+
+    // Edges to the same coarse vertex are combined, using where[] to
+    // find the one already in the row
+    std::vector<int64_t> where(nc, -1);
+    coarse.xadj.reserve(nc + 1);
+    coarse.xadj.push_back(0);
+    coarse.adjncy.reserve(g.adjncy.size() / 2);
+    coarse.adjwgt.reserve(g.adjncy.size() / 2);
+    for ( uint32_t c = 0; c < nc; c++ ) {
+        uint64_t start = coarse.adjncy.size();
+        for ( uint32_t m = first[c]; m < first[c + 1]; m++ ) {
+            uint32_t v = members[m];
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v + 1]; e++ ) {
+                uint32_t cu = g.cmap[g.adjncy[e]];
+                if ( cu == c ) continue;
+                if ( where[cu] == -1 ) {
+                    where[cu] = coarse.adjncy.size();
+                    coarse.adjncy.push_back(cu);
+                    coarse.adjwgt.push_back(g.adjwgt[e]);
+                }
+                else {
+                    coarse.adjwgt[where[cu]] += g.adjwgt[e];
+                }
+            }
+        }
+        for ( uint64_t e = start; e < coarse.adjncy.size(); e++ ) {
+            where[coarse.adjncy[e]] = -1;
+        }
+        coarse.xadj.push_back(coarse.adjncy.size());
+    }
+}
+
+// Cut a breadth first ordering of the vertices into pieces of equal
+// weight, so that each part starts out mostly connected
+static void
+initialPartition(const Level& g, uint32_t k, std::vector<uint32_t>& part)
+{
+    uint32_t n = g.size();
+
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    std::vector<bool> seen(n, false);
+    for ( uint32_t s = 0; s < n; s++ ) {
+        if ( seen[s] ) continue;
+        seen[s] = true;
+        order.push_back(s);
+        for ( size_t head = order.size() - 1; head < order.size(); head++ ) {
+            uint32_t v = order[head];
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v + 1]; e++ ) {
+                uint32_t u = g.adjncy[e];
+                if ( seen[u] ) continue;
+                seen[u] = true;
+                order.push_back(u);
+            }
+        }
+    }
+
+    double total = 0.0;
+    for ( uint32_t v = 0; v < n; v++ ) total += g.vwgt[v];
+
+    part.resize(n);
+    double acc = 0.0;
+    for ( uint32_t i = 0; i < n; i++ ) {
+        uint32_t v = order[i];
+        // Without weights, split by count
+        double w = total > 0.0 ? g.vwgt[v] : 1.0;
+        double t = total > 0.0 ? total : n;
+        uint32_t p = (uint32_t)((acc + w / 2) * k / t);
+        part[v] = p < k ? p : k - 1;
+        acc += w;
+    }
+}
+
+// Move vertices on part boundaries to the neighboring part that most
+// lowers the weight of the cut edges, as long as no part goes over
+// limit.  Moves that don't change the cut are made if they even out
+// the parts, and a part over limit gives up vertices even at a loss.
+static void
+refine(const Level& g, uint32_t k, double limit, std::vector<uint32_t>& part)
+{
+    uint32_t n = g.size();
+
+    std::vector<double> pwgt(k, 0.0);
+    for ( uint32_t v = 0; v < n; v++ ) pwgt[part[v]] += g.vwgt[v];
+
+    std::vector<int64_t> conn(k, 0);
+    std::vector<uint32_t> touched;
+    for ( int pass = 0; pass < REFINE_PASSES; pass++ ) {
+        uint64_t moves = 0;
+        for ( uint32_t v = 0; v < n; v++ ) {
+            uint32_t from = part[v];
+            bool boundary = false;
+            touched.clear();
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v + 1]; e++ ) {
+                uint32_t p = part[g.adjncy[e]];
+                if ( conn[p] == 0 ) touched.push_back(p);
+                conn[p] += g.adjwgt[e];
+                if ( p != from ) boundary = true;
+            }
+
+            if ( boundary ) {
+                bool over = pwgt[from] > limit;
+                uint32_t to = from;
+                int64_t best_gain = 0;
+                for ( size_t i = 0; i < touched.size(); i++ ) {
+                    uint32_t p = touched[i];
+                    if ( p == from || pwgt[p] + g.vwgt[v] > limit ) continue;
+                    int64_t gain = conn[p] - conn[from];
+                    bool better;
+                    if ( to == from ) {
+                        better = gain > 0 || over || (gain == 0 && pwgt[p] + g.vwgt[v] < pwgt[from]);
+                    }
+                    else {
+                        better = gain > best_gain || (gain == best_gain && pwgt[p] < pwgt[to]);
+                    }
+                    if ( better ) {
+                        to = p;
+                        best_gain = gain;
+                    }
+                }
+                if ( to != from ) {
+                    part[v] = to;
+                    pwgt[from] -= g.vwgt[v];
+                    pwgt[to] += g.vwgt[v];
+                    moves++;
+                }
+            }
+
+            for ( size_t i = 0; i < touched.size(); i++ ) conn[touched[i]] = 0;
+        }
+        if ( moves == 0 ) break;
+    }
+}
+
+// Split g into k parts of balanced vertex weight.  Coarse levels are
+// only needed until the level below is refined, and a deque keeps the
+// levels in place as more are added.
+static void
+partitionGraph(Level& g, const std::vector<uint8_t>& latency_index, size_t num_latencies,
+               uint32_t k, std::vector<uint32_t>& part, Output* out, uint32_t verbose_level)
+{
+    uint32_t n = g.size();
+    part.resize(n);
+    if ( k == 1 || n <= k ) {
+        for ( uint32_t v = 0; v < n; v++ ) part[v] = v % k;
+        return;
+    }
+
+    double total = 0.0;
+    for ( uint32_t v = 0; v < n; v++ ) total += g.vwgt[v];
+
+    // The groups are never split, so the grouped graph is the finest
+    // one refined
+    std::deque<Level> levels;
+    size_t finest = 0;
+    size_t joined;
+    uint32_t ng = groupLowLatency(g, latency_index, num_latencies, MAX_GROUP_SHARE * total / k, joined);
+    if ( ng < n ) {
+        levels.push_back(Level());
+        contract(g, ng, levels.back());
+        finest = 1;
+        out->verbose(CALL_INFO, verbose_level, 0, "- Grouped components joined by the %zu lowest latencies into %u groups\n",
+                     joined, ng);
+    }
+
+    uint32_t coarsen_to = COARSEN_PER_PART * k;
+    double max_vwgt = 1.5 * total / coarsen_to;
+    while ( (levels.empty() ? g : levels.back()).size() > coarsen_to ) {
+        Level& fine = levels.empty() ? g : levels.back();
+        uint32_t nc = match(fine, max_vwgt);
+        if ( nc > COARSEN_MIN_SHRINK * fine.size() ) break;
+        levels.push_back(Level());
+        contract(fine, nc, levels.back());
+    }
+    out->verbose(CALL_INFO, verbose_level, 0, "- Coarsened %u components in %zu levels to %u\n",
+                 n, levels.size(), (levels.empty() ? g : levels.back()).size());
+
+    initialPartition(levels.empty() ? g : levels.back(), k, part);
+    while ( true ) {
+        const Level& coarse = levels.empty() ? g : levels.back();
+        // Coarse levels can't balance better than their heaviest vertex
+        double max_vertex = *std::max_element(coarse.vwgt.begin(), coarse.vwgt.end());
+        double limit = std::max(IMBALANCE * total / k, total / k + max_vertex);
+        refine(coarse, k, limit, part);
+        if ( levels.size() == finest ) break;
+
+        levels.pop_back();
+        const Level& fine = levels.empty() ? g : levels.back();
+        std::vector<uint32_t> fine_part(fine.size());
+        for ( uint32_t v = 0; v < fine.size(); v++ ) fine_part[v] = part[fine.cmap[v]];
+        part.swap(fine_part);
+    }
+    if ( finest == 1 ) {
+        std::vector<uint32_t> fine_part(n);
+        for ( uint32_t v = 0; v < n; v++ ) fine_part[v] = part[g.cmap[v]];
+        part.swap(fine_part);
+    }
+}
+
+// Split each rank of rank_part among its threads, looking only at the
+// links inside the rank
+static void
+partitionThreads(const Level& g, const std::vector<uint8_t>& latency_index, size_t num_latencies,
+                 const std::vector<uint32_t>& rank_part, RankInfo rankcount,
+                 std::vector<uint32_t>& part, Output* out)
+{
+    uint32_t n = g.size();
+
+    std::vector<uint32_t> first(rankcount.rank + 1, 0);
+    for ( uint32_t v = 0; v < n; v++ ) first[rank_part[v] + 1]++;
+    for ( uint32_t r = 0; r < rankcount.rank; r++ ) first[r + 1] += first[r];
+    std::vector<uint32_t> members(n);
+    std::vector<uint32_t> local(n);
+    std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+    for ( uint32_t v = 0; v < n; v++ ) {
+        local[v] = fill[rank_part[v]] - first[rank_part[v]];
+        members[fill[rank_part[v]]++] = v;
+    }
+
+    part.resize(n);
+    for ( uint32_t r = 0; r < rankcount.rank; r++ ) {
+        Level sub;
+        std::vector<uint8_t> sub_index;
+        sub.xadj.push_back(0);
+        for ( uint32_t m = first[r]; m < first[r + 1]; m++ ) {
+            uint32_t v = members[m];
+            sub.vwgt.push_back(g.vwgt[v]);
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v + 1]; e++ ) {
+                uint32_t u = g.adjncy[e];
+                if ( rank_part[u] != r ) continue;
+                sub.adjncy.push_back(local[u]);
+                sub.adjwgt.push_back(g.adjwgt[e]);
+                sub_index.push_back(latency_index[e]);
+            }
+            sub.xadj.push_back(sub.adjncy.size());
+        }
+
+        std::vector<uint32_t> sub_part;
+        partitionGraph(sub, sub_index, num_latencies, rankcount.thread, sub_part, out, 2);
+        for ( uint32_t m = first[r]; m < first[r + 1]; m++ ) {
+            part[members[m]] = r * rankcount.thread + sub_part[m - first[r]];
+        }
+    }
+}
+
+SSTMultilevelPartition::SSTMultilevelPartition(RankInfo mpiranks, int verbosity, bool hierarchical) :
+	hierarchical(hierarchical)
+{
+	rankcount = mpiranks;
+	partOutput = new Output("MultilevelPartition ", verbosity, 0, SST::Output::STDOUT);
+}
+
+SSTMultilevelPartition::~SSTMultilevelPartition() {
+	delete partOutput;
+}
+
+void SSTMultilevelPartition::performPartition(PartitionGraph* graph) {
+	assert(rankcount.rank > 0);
+
+	PartitionComponentMap_t& compMap = graph->getComponentMap();
+
+	partOutput->verbose(CALL_INFO, 1, 0, "Performing a multilevel partition scheme for simulation model.\n");
+
+	Level g;
+	std::vector<ComponentId_t> ids;
+	bool dense;
+	std::vector<uint8_t> latency_index;
+	size_t num_latencies = buildGraph(graph, g, ids, dense, latency_index);
+
+	// Parts are numbered rank by rank
+	std::vector<uint32_t> part;
+	if ( hierarchical && rankcount.rank > 1 && rankcount.thread > 1 ) {
+		// Cuts between ranks cost much more than cuts between threads
+		// of a rank, so the ranks are split first and each rank is
+		// then split among its threads
+		std::vector<uint32_t> rank_part;
+		partitionGraph(g, latency_index, num_latencies, rankcount.rank, rank_part, partOutput, 1);
+		partitionThreads(g, latency_index, num_latencies, rank_part, rankcount, part, partOutput);
+	}
+	else {
+		partitionGraph(g, latency_index, num_latencies, rankcount.rank * rankcount.thread, part, partOutput, 1);
+	}
+
+	uint32_t v = 0;
+	for ( PartitionComponentMap_t::iterator compItr = compMap.begin();
+		  compItr != compMap.end(); ++compItr, ++v ) {
+		compItr->rank = RankInfo(part[v] / rankcount.thread, part[v] % rankcount.thread);
+	}
+
+	if ( partOutput->getVerboseLevel() >= 1 ) {
+		PartitionLinkMap_t& links = graph->getLinkMap();
+		uint64_t cut = 0;
+		SimTime_t min_cut_latency = MAX_SIMTIME_T;
+		for ( PartitionLinkMap_t::iterator it = links.begin(); it != links.end(); ++it ) {
+			uint32_t a = vertexOf(ids, dense, it->component[0]);
+			uint32_t b = vertexOf(ids, dense, it->component[1]);
+			if ( part[a] == part[b] ) continue;
+			cut++;
+			if ( it->getMinLatency() < min_cut_latency ) min_cut_latency = it->getMinLatency();
+		}
+		partOutput->verbose(CALL_INFO, 1, 0, "- Cut links:                        %10" PRIu64 "\n", cut);
+		if ( cut > 0 ) {
+			partOutput->verbose(CALL_INFO, 1, 0, "- Minimum cut link latency:         %10" PRIu64 "\n", min_cut_latency);
+		}
+	}
+
+	partOutput->verbose(CALL_INFO, 1, 0, "Multilevel partition scheme completed.\n");
+}
+
+} // namespace Partition
+} // namespace SST
@@ -0,0 +1,97 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_PART_MULTILEVEL
+#define SST_CORE_PART_MULTILEVEL
+
+#include <sst/core/part/sstpart.h>
+
+namespace SST {
+
+class Output;
+
+namespace Partition {
+
+/**
+Performs a multilevel partition of an SST simulation configuration.
+
+Components joined by the lowest latency links are first grouped, one
+latency at a time, for as long as the groups stay small next to a part.
+The groups are never split, so the minimum latency of the cut links
+(the lookahead of the parallel simulation) is as high as the balance
+allows.  The grouped graph is then coarsened by repeatedly merging
+pairs joined by the heaviest links, the coarsest graph is split into
+one part per thread, and the parts are refined at each level on the
+way back, moving vertices on part boundaries when that lowers the
+weight of the cut links without unbalancing the parts.
+
+Links are weighted by latency, with each step down in latency weighing
+much more than the one above it, so among the links left to cut the
+higher latency ones go first, and fewer cuts are preferred among links
+of the same latency.  Links that carried more events in a profiled run
+(see PartitionProfile) weigh more within their latency.  Parts are
+balanced by component weight.
+
+In hierarchical mode the graph is first split into one part per rank,
+and each rank is then split among its threads looking only at the
+links inside it.  Cuts between ranks cost far more than cuts between
+threads, so this trades cheap thread cuts for a higher lookahead
+between ranks.
+
+Every step is linear in the size of the graph, so large graphs can be
+partitioned quickly.
+*/
+class SSTMultilevelPartition : public SST::Partition::SSTPartitioner {
+
+	public:
+		/**
+			Creates a new multilevel partition scheme.
+			\param rankCount Number of ranks and threads in the simulation
+			\param verbosity The level of information to output
+			\param hierarchical Split the ranks before the threads
+		*/
+		SSTMultilevelPartition(RankInfo rankCount, int verbosity, bool hierarchical = false);
+		~SSTMultilevelPartition();
+
+		/**
+			Performs a partition of an SST simulation configuration
+			\param graph The simulation configuration to partition
+		*/
+		void performPartition(PartitionGraph* graph);
+
+        bool requiresConfigGraph() { return false; }
+        bool spawnOnAllRanks() { return false; }
+
+        static SSTPartitioner* allocate(RankInfo total_ranks, RankInfo my_rank, int verbosity) {
+            return new SSTMultilevelPartition(total_ranks, verbosity);
+        }
+
+        static SSTPartitioner* allocateHierarchical(RankInfo total_ranks, RankInfo my_rank, int verbosity) {
+            return new SSTMultilevelPartition(total_ranks, verbosity, true);
+        }
+
+	protected:
+        /** Number of ranks in the simulation */
+		RankInfo rankcount;
+        /** Output object to print partitioning information */
+		Output* partOutput;
+        /** Split the ranks before the threads */
+        bool hierarchical;
+
+        static bool initialized;
+        static bool initialized_hierarchical;
+};
+
+}
+}
+
+#endif
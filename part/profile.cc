@@ -0,0 +1,163 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/part/profile.h>
+
+#include <sst/core/configGraph.h>
+#include <sst/core/output.h>
+
+#include <sstream>
+
+namespace SST {
+namespace Partition {
+
+void
+PartitionProfile::addComponent(ComponentId_t id, const std::string& name, uint64_t handlers, double time)
+{
+    ComponentCounts& counts = components[id];
+    counts.name = name;
+    counts.handlers += handlers;
+    counts.time += time;
+}
+
+void
+PartitionProfile::addLink(LinkId_t id, uint64_t events)
+{
+    links[id] += events;
+}
+
+void
+PartitionProfile::merge(const PartitionProfile& other)
+{
+    for ( std::map<ComponentId_t, ComponentCounts>::const_iterator it = other.components.begin();
+          it != other.components.end(); ++it ) {
+        addComponent(it->first, it->second.name, it->second.handlers, it->second.time);
+    }
+    for ( std::map<LinkId_t, uint64_t>::const_iterator it = other.links.begin(); it != other.links.end(); ++it ) {
+        addLink(it->first, it->second);
+    }
+}
+
+// One line per component or link:
+//   component <id> <handlers> <seconds> <name>
+//   link <id> <events>
+// The name goes last since nothing stops it from holding spaces.
+void
+PartitionProfile::write(std::ostream& os) const
+{
+    os.precision(17);
+    os << "# SST partition profile" << std::endl;
+    for ( std::map<ComponentId_t, ComponentCounts>::const_iterator it = components.begin();
+          it != components.end(); ++it ) {
+        os << "component " << it->first << " " << it->second.handlers << " "
+           << it->second.time << " " << it->second.name << std::endl;
+    }
+    for ( std::map<LinkId_t, uint64_t>::const_iterator it = links.begin(); it != links.end(); ++it ) {
+        os << "link " << it->first << " " << it->second << std::endl;
+    }
+}
+
+bool
+PartitionProfile::read(std::istream& is)
+{
+    std::string line;
+    bool header = false;
+    while ( std::getline(is, line) ) {
+        if ( line.empty() ) continue;
+        if ( line[0] == '#' ) {
+            if ( line == "# SST partition profile" ) header = true;
+            continue;
+        }
+        if ( !header ) return false;
+
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if ( kind == "component" ) {
+            ComponentId_t id;
+            uint64_t handlers;
+            double time;
+            std::string name;
+            fields >> id >> handlers >> time;
+            fields.get();
+            std::getline(fields, name);
+            if ( fields.fail() ) return false;
+            addComponent(id, name, handlers, time);
+        }
+        else if ( kind == "link" ) {
+            LinkId_t id;
+            uint64_t events;
+            fields >> id >> events;
+            if ( fields.fail() ) return false;
+            addLink(id, events);
+        }
+        else {
+            return false;
+        }
+    }
+    return header;
+}
+
+bool
+PartitionProfile::apply(ConfigGraph* graph, Output& out) const
+{
+    ConfigComponentMap_t& comps = graph->getComponentMap();
+    ConfigLinkMap_t& graph_links = graph->getLinkMap();
+
+    uint64_t total_handlers = 0;
+    double total_time = 0.0;
+    size_t found = 0;
+    for ( ConfigComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
+        std::map<ComponentId_t, ComponentCounts>::const_iterator counts = components.find(it->id);
+        if ( counts == components.end() ) continue;
+        if ( counts->second.name != it->name ) {
+            out.output("WARNING: Partition profile has component %s where the model has %s, not using it.\n",
+                       counts->second.name.c_str(), it->name.c_str());
+            return false;
+        }
+        total_handlers += counts->second.handlers;
+        total_time += counts->second.time;
+        found++;
+    }
+    if ( found == 0 ) {
+        out.output("WARNING: Partition profile has none of the components in the model, not using it.\n");
+        return false;
+    }
+
+    // Measured time is the better weight, but short runs may not
+    // register any
+    bool use_time = total_time > 0.0;
+    double mean = use_time ? total_time / found : (double)total_handlers / found;
+    for ( ConfigComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
+        std::map<ComponentId_t, ComponentCounts>::const_iterator counts = components.find(it->id);
+        if ( counts == components.end() || mean == 0.0 ) {
+            it->weight = 1.0;
+            continue;
+        }
+        double value = use_time ? counts->second.time : (double)counts->second.handlers;
+        it->weight = value / mean;
+    }
+
+    for ( ConfigLinkMap_t::iterator it = graph_links.begin(); it != graph_links.end(); ++it ) {
+        std::map<LinkId_t, uint64_t>::const_iterator events = links.find(it->id);
+        it->event_count = events == links.end() ? 0 : events->second;
+    }
+
+    if ( found < comps.size() ) {
+        out.output("WARNING: Partition profile is missing %zu of the %zu components in the model.\n",
+                   comps.size() - found, comps.size());
+    }
+    return true;
+}
+
+} // namespace Partition
+} // namespace SST
@@ -0,0 +1,84 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_PART_PROFILE
+#define SST_CORE_PART_PROFILE
+
+#include <sst/core/sst_types.h>
+
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace SST {
+
+class ConfigGraph;
+class Output;
+
+namespace Partition {
+
+/**
+ * Handler and link counts from a run of a model, used to weight the
+ * partition of later runs of the same model.
+ *
+ * A run started with --output-profile counts, for each component, the
+ * event and clock handlers it runs and the time they take, and for
+ * each link, the events delivered on it.  A run started with
+ * --partition-profile sets the component weights and link event counts
+ * of its ConfigGraph from the file before partitioning.
+ *
+ * Components and links are matched by ID, which is the same from run
+ * to run of the same model.  Component names are kept to catch a
+ * profile of a different model.
+ */
+class PartitionProfile {
+public:
+    PartitionProfile() {}
+
+    /** Add the counts of a component */
+    void addComponent(ComponentId_t id, const std::string& name, uint64_t handlers, double time);
+    /** Add the events delivered on one side of a link */
+    void addLink(LinkId_t id, uint64_t events);
+    /** Add the counts of another profile */
+    void merge(const PartitionProfile& other);
+
+    /** Write the profile in text form */
+    void write(std::ostream& os) const;
+    /** Read a profile written by write(), adding its counts to this one.
+     * Returns false if the input is not a profile. */
+    bool read(std::istream& is);
+
+    /** Set the component weights and link event counts of graph from
+     * the profile.  Component weights are the time spent in their
+     * handlers (or the number of handlers run, if no time was
+     * measured), scaled so the average is 1.  Components not in the
+     * profile get a weight of 1.  Returns false, leaving graph
+     * unchanged, if the profile is of a different model. */
+    bool apply(ConfigGraph* graph, Output& out) const;
+
+private:
+    struct ComponentCounts {
+        std::string name;
+        uint64_t handlers;
+        double time;        // seconds
+
+        ComponentCounts() : handlers(0), time(0.0) {}
+    };
+
+    std::map<ComponentId_t, ComponentCounts> components;
+    std::map<LinkId_t, uint64_t> links;
+};
+
+} // namespace Partition
+} // namespace SST
+
+#endif
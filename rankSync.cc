@@ -20,10 +20,6 @@
 #include "sst/core/syncQueue.h"
 #include "sst/core/timeConverter.h"
 
-#include <boost/archive/polymorphic_binary_iarchive.hpp>
-#include <boost/iostreams/stream_buffer.hpp>
-#include <boost/iostreams/stream.hpp>
-
 #ifdef SST_CONFIG_HAVE_MPI
 #include <mpi.h>
 #endif
@@ -273,8 +269,8 @@ RankSync::sendQueuedEvents(comm_pair_send& send_info, MPI_Request* request)
 #endif
 
 #ifdef SST_CONFIG_HAVE_MPI
-std::vector<Activity*>*
-RankSync::recvEvents(comm_pair_recv& recv_info)
+void
+RankSync::recvEvents(comm_pair_recv& recv_info, SimTime_t current_cycle)
 {
     // Get the buffer and deserialize all the events
     char* buffer = recv_info.rbuf;
@@ -298,14 +294,19 @@ RankSync::recvEvents(comm_pair_recv& recv_info)
     }
     
     auto deserialStart = SST::Core::Profile::now();
-    boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-    boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-    boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-    
-    std::vector<Activity*>* activities = new std::vector<Activity*>();
-    ia >> *activities;
+    SyncQueue::unpackData(buffer, [&](Activity* activity) {
+        Event* ev = static_cast<Event*>(activity);
+        link_map_t::iterator link = link_map.find(ev->getLinkId());
+        if (link == link_map.end()) {
+            printf("Link not found in map!\n");
+            abort();
+        } else {
+            // Need to figure out what the "delay" is for this event.
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            link->second->send(delay,ev);
+        }
+    });
     deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
-    return activities;
     
 }
 #endif
@@ -400,22 +401,7 @@ RankSync::execute(void)
         ia >> activities;
 #endif
 
-        std::vector<Activity*>* activities_ptr = recvEvents(i->second);
-        std::vector<Activity*>& activities = *activities_ptr;
-        
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-            
-            Event* ev = static_cast<Event*>(activities[j]);
-            link_map_t::iterator link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
-                abort();
-            } else {
-                // Need to figure out what the "delay" is for this event.
-                SimTime_t delay = ev->getDeliveryTime() - current_cycle;
-                link->second->send(delay,ev);
-            }
-        }
+        recvEvents(i->second, current_cycle);
         
         // for ( int j = 0; j < count; j++ ) {
         //     Event* ev;
@@ -538,16 +524,8 @@ RankSync::exchangeLinkInitData(int msg_count)
             buffer = i->second.rbuf;
         }
         
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        
-        std::vector<Activity*> activities;
-        ia >> activities;
-
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-            
-            Event* ev = static_cast<Event*>(activities[j]);
+        SyncQueue::unpackData(buffer, [&](Activity* activity) {
+            Event* ev = static_cast<Event*>(activity);
             link_map_t::iterator link = link_map.find(ev->getLinkId());
             if (link == link_map.end()) {
                 printf("Link not found in map!\n");
@@ -555,7 +533,7 @@ RankSync::exchangeLinkInitData(int msg_count)
             } else {
                 sendInitData_sync(link->second,ev);
             }
-        }
+        });
         
         
         // for ( int j = 0; j < count; j++ ) {
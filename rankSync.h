@@ -67,7 +67,7 @@ private:
 
 #ifdef SST_CONFIG_HAVE_MPI
     int sendQueuedEvents(comm_pair_send& send_info, MPI_Request* request);
-    std::vector<Activity*>* recvEvents(comm_pair_recv& recv_info);
+    void recvEvents(comm_pair_recv& recv_info, SimTime_t current_cycle);
 #endif
     
     // typedef std::map<int, std::pair<SyncQueueC*, std::vector<char>* > > comm_map_t;
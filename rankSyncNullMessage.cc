@@ -0,0 +1,354 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/rankSyncNullMessage.h"
+
+#include "sst/core/event.h"
+#include "sst/core/exit.h"
+#include "sst/core/link.h"
+#include "sst/core/output.h"
+#include "sst/core/profile.h"
+#include "sst/core/simulation.h"
+#include "sst/core/timeConverter.h"
+
+namespace SST {
+
+RankSyncNullMessage::RankSyncNullMessage(TimeConverter* minPartTC) :
+    NewRankSync(),
+    rbuf(new char[4096]),
+    rbuf_size(4096),
+    finished(false),
+    syncCount(0),
+    dataMessages(0),
+    nullMessages(0),
+    mpiWaitTime(0.0),
+    exitWaitTime(0.0),
+    deserializeTime(0.0)
+{
+    sim = Simulation::getSimulation();
+    exit = sim->getExit();
+    max_period = minPartTC;
+
+    // Nothing sent from another rank can arrive before the partition
+    // lookahead, so that is where the first sync goes
+    nextSyncTime = minPartTC->getFactor();
+    checkPeriod = EXIT_CHECK_WINDOWS * minPartTC->getFactor();
+    nextCheck = checkPeriod;
+}
+
+RankSyncNullMessage::~RankSyncNullMessage()
+{
+    double serializeTime = 0.0;
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        serializeTime += i->second.squeue->getSerializeTime();
+        delete i->second.squeue;
+        for ( size_t j = 0; j < i->second.links.size(); j++ ) {
+            delete i->second.links[j];
+        }
+    }
+    peers.clear();
+
+    delete[] rbuf;
+
+    if ( syncCount > 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncNullMessage %" PRIu64 " syncs  %" PRIu64 " data messages  %" PRIu64 " null messages  mpiWait: %lg sec  exitWait: %lg sec  "
+                                           "serialize: %lg sec (%lg usec/sync)  deserialize: %lg sec (%lg usec/sync)\n",
+                                           syncCount, dataMessages, nullMessages, mpiWaitTime, exitWaitTime,
+                                           serializeTime, 1e6 * serializeTime / syncCount,
+                                           deserializeTime, 1e6 * deserializeTime / syncCount);
+}
+
+ActivityQueue*
+RankSyncNullMessage::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
+{
+    peer_map_t::iterator i = peers.find(to_rank.rank);
+    if ( i == peers.end() ) {
+        peer_t peer;
+        peer.squeue = new SyncQueue();
+        peer.lookahead = MAX_SIMTIME_T;
+        // Every rank starts out bound by the partition lookahead
+        peer.recv_bound = nextSyncTime;
+        peer.send_bound = 0;
+#ifdef SST_CONFIG_HAVE_MPI
+        peer.data_req = MPI_REQUEST_NULL;
+        peer.null_req = MPI_REQUEST_NULL;
+#endif
+        i = peers.insert(std::make_pair(to_rank.rank, peer)).first;
+    }
+
+    SimTime_t latency = getSendLatency(link);
+    if ( latency < i->second.lookahead ) i->second.lookahead = latency;
+
+    setSyncIndex(link, i->second.links.size());
+    i->second.links.push_back(link);
+#ifdef __SST_DEBUG_EVENT_TRACKING__
+    link->setSendingComponentInfo("SYNC", "SYNC", "");
+#endif
+    return i->second.squeue;
+}
+
+void
+RankSyncNullMessage::finalizeLinkConfigurations()
+{
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        for ( size_t j = 0; j < i->second.links.size(); j++ ) {
+            finalizeConfiguration(i->second.links[j]);
+        }
+    }
+}
+
+uint64_t
+RankSyncNullMessage::getDataSize() const
+{
+    size_t count = rbuf_size;
+    for ( peer_map_t::const_iterator i = peers.begin(); i != peers.end(); ++i ) {
+        count += i->second.squeue->getDataSize();
+    }
+    return count;
+}
+
+void
+RankSyncNullMessage::execute(int thread)
+{
+    SimTime_t current = sim->getCurrentSimCycle();
+    syncCount++;
+
+    // Nothing this rank sends from now on can arrive at a peer before
+    // the current time plus the lookahead to that peer
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        sendData(i->first, i->second, current + i->second.lookahead);
+    }
+
+    // Wait until the bounds from all the peers are past the current
+    // time.  Everything they sent before those bounds has then been
+    // received.
+    auto waitStart = SST::Core::Profile::now();
+    while ( true ) {
+        receive();
+        if ( computeBound(current) > current ) break;
+    }
+    mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+    // Every rank syncs exactly at the check points, so they all take
+    // part in the same reductions and see the same result
+    if ( current >= nextCheck ) {
+        auto checkStart = SST::Core::Profile::now();
+        exit->startCheck();
+        while ( !exit->testCheck() ) {
+            receive();
+        }
+        exitWaitTime += SST::Core::Profile::getElapsed(checkStart);
+        nextCheck += checkPeriod;
+    }
+
+    SimTime_t bound = computeBound(current);
+    nextSyncTime = bound < nextCheck ? bound : nextCheck;
+
+    // Until the next sync this rank only runs what is already in its
+    // TimeVortex, so the peers may be able to go further than the
+    // bounds just sent
+    SimTime_t next = sim->getNextActivityTime();
+    if ( next > nextSyncTime ) next = nextSyncTime;
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        if ( next + i->second.lookahead > i->second.send_bound ) {
+            sendNull(i->first, i->second, next + i->second.lookahead);
+        }
+    }
+}
+
+SimTime_t
+RankSyncNullMessage::computeBound(SimTime_t current)
+{
+    SimTime_t bound = MAX_SIMTIME_T;
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        SimTime_t limit = i->second.recv_bound;
+        if ( limit == MAX_SIMTIME_T ) limit = current + i->second.lookahead;
+        if ( limit < bound ) bound = limit;
+    }
+    return bound;
+}
+
+void
+RankSyncNullMessage::sendData(int rank, peer_t& peer, SimTime_t bound)
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    // The spare buffer is the one sent last time
+    waitSend(&peer.data_req);
+
+    char* buffer = peer.squeue->getData();
+    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+    hdr->mode = 0;
+    hdr->time = bound;
+    if ( hdr->count > 0 ) dataMessages++;
+    else nullMessages++;
+
+    MPI_Isend(buffer, hdr->buffer_size, MPI_BYTE, rank, SYNC_TAG, MPI_COMM_WORLD, &peer.data_req);
+    peer.squeue->swapBuffers();
+    peer.send_bound = bound;
+#endif
+}
+
+void
+RankSyncNullMessage::sendNull(int rank, peer_t& peer, SimTime_t bound)
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    waitSend(&peer.null_req);
+
+    peer.null_hdr.mode = 0;
+    peer.null_hdr.count = 0;
+    peer.null_hdr.buffer_size = sizeof(SyncQueue::Header);
+    peer.null_hdr.time = bound;
+    nullMessages++;
+
+    MPI_Isend(&peer.null_hdr, sizeof(SyncQueue::Header), MPI_BYTE, rank, SYNC_TAG, MPI_COMM_WORLD, &peer.null_req);
+    peer.send_bound = bound;
+#endif
+}
+
+#ifdef SST_CONFIG_HAVE_MPI
+void
+RankSyncNullMessage::waitSend(MPI_Request* req)
+{
+    int flag;
+    while ( true ) {
+        MPI_Test(req, &flag, MPI_STATUS_IGNORE);
+        if ( flag ) return;
+        receive();
+    }
+}
+#endif
+
+void
+RankSyncNullMessage::receive()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    SimTime_t current_cycle = sim->getCurrentSimCycle();
+    while ( true ) {
+        int flag;
+        MPI_Status status;
+        MPI_Iprobe(MPI_ANY_SOURCE, SYNC_TAG, MPI_COMM_WORLD, &flag, &status);
+        if ( !flag ) return;
+
+        int size;
+        MPI_Get_count(&status, MPI_BYTE, &size);
+        if ( (uint32_t)size > rbuf_size ) {
+            delete[] rbuf;
+            rbuf = new char[size];
+            rbuf_size = size;
+        }
+        MPI_Recv(rbuf, size, MPI_BYTE, status.MPI_SOURCE, SYNC_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+        peer_map_t::iterator peer = peers.find(status.MPI_SOURCE);
+        if ( peer == peers.end() ) {
+            printf("Message from unknown rank!\n");
+            abort();
+        }
+
+        // Messages from one rank arrive in the order sent, so the
+        // bound never goes down
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(rbuf);
+        peer->second.recv_bound = hdr->time;
+
+        auto deserialStart = SyncQueue::now();
+        std::vector<Link*>& links = peer->second.links;
+        SyncQueue::unpackData(rbuf, [&](Activity* activity) {
+            if ( finished ) {
+                delete activity;
+                return;
+            }
+            // Events carry the sync index of their link
+            Event* ev = static_cast<Event*>(activity);
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            links[ev->getSyncIndex()]->send(delay,ev);
+        });
+        deserializeTime += SyncQueue::getElapsed(deserialStart);
+    }
+#endif
+}
+
+void
+RankSyncNullMessage::finish()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    finished = true;
+
+    // Release any peer still waiting on this rank
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        sendNull(i->first, i->second, MAX_SIMTIME_T);
+    }
+
+    // Keep receiving until every peer has finished as well, so that
+    // all the sends on both sides get matched
+    bool done = false;
+    while ( !done ) {
+        receive();
+        done = true;
+        for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+            if ( i->second.recv_bound != MAX_SIMTIME_T ) done = false;
+        }
+    }
+
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        MPI_Wait(&i->second.data_req, MPI_STATUS_IGNORE);
+        MPI_Wait(&i->second.null_req, MPI_STATUS_IGNORE);
+    }
+#endif
+}
+
+void
+RankSyncNullMessage::exchangeLinkInitData(int thread, std::atomic<int>& msg_count)
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    // One message each way between every pair of peers.  The sizes
+    // are taken from the probe, so no size exchange is needed.
+    std::vector<MPI_Request> sreqs;
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        char* send_buffer = i->second.squeue->getData();
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
+        hdr->mode = 0;
+        sreqs.push_back(MPI_REQUEST_NULL);
+        MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE, i->first, INIT_TAG, MPI_COMM_WORLD, &sreqs.back());
+    }
+
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        MPI_Status status;
+        MPI_Probe(i->first, INIT_TAG, MPI_COMM_WORLD, &status);
+        int size;
+        MPI_Get_count(&status, MPI_BYTE, &size);
+        if ( (uint32_t)size > rbuf_size ) {
+            delete[] rbuf;
+            rbuf = new char[size];
+            rbuf_size = size;
+        }
+        MPI_Recv(rbuf, size, MPI_BYTE, i->first, INIT_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+        std::vector<Link*>& links = i->second.links;
+        SyncQueue::unpackData(rbuf, [&](Activity* activity) {
+            Event* ev = static_cast<Event*>(activity);
+            sendInitData_sync(links[ev->getSyncIndex()],ev);
+        });
+    }
+
+    MPI_Waitall(sreqs.size(), sreqs.data(), MPI_STATUSES_IGNORE);
+    for (peer_map_t::iterator i = peers.begin() ; i != peers.end() ; ++i) {
+        i->second.squeue->clear();
+    }
+
+    // Do an allreduce to see if there were any messages sent
+    int input = msg_count;
+    int count;
+    MPI_Allreduce( &input, &count, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
+    msg_count = count;
+#endif
+}
+
+} // namespace SST
@@ -0,0 +1,128 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_RANKSYNCNULLMESSAGE_H
+#define SST_CORE_RANKSYNCNULLMESSAGE_H
+
+#include "sst/core/sst_types.h"
+#include <sst/core/syncManager.h>
+#include <sst/core/syncQueue.h>
+
+#include <map>
+#include <vector>
+
+#ifdef SST_CONFIG_HAVE_MPI
+#include <mpi.h>
+#endif
+
+namespace SST {
+
+class Exit;
+class Simulation;
+class TimeConverter;
+
+/**
+ * Conservative (Chandy-Misra-Bryant) rank sync.
+ *
+ * Every message sent to a peer rank carries a bound: nothing sent on
+ * that channel later will be delivered before it.  The bound is the
+ * sender's current time plus the minimum latency of its links to the
+ * peer, so each pair of ranks uses its own lookahead.  A rank only
+ * waits until the bounds from its own peers let it move past the
+ * current time, and the next sync is set by the lowest bound.  If
+ * there are no events for a peer, a header-only null message carries
+ * the bound instead.  The rank with the lowest time always has bounds
+ * above it, so this can't deadlock.
+ *
+ * The exit is checked with a global reduction at fixed points in
+ * simulated time, which every rank reaches, so all ranks end at the
+ * same time.  Only used with one thread per rank.
+ */
+class RankSyncNullMessage : public NewRankSync {
+public:
+    RankSyncNullMessage(TimeConverter* minPartTC);
+    virtual ~RankSyncNullMessage();
+
+    /** Register a Link which this Sync Object is responsible for */
+    ActivityQueue* registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link);
+    void execute(int thread);
+
+    /** Cause an exchange of Initialization Data to occur */
+    void exchangeLinkInitData(int thread, std::atomic<int>& msg_count);
+    /** Finish link configuration */
+    void finalizeLinkConfigurations();
+    /** Tell the peers this rank is done and drain the channels */
+    void finish();
+
+    uint64_t getDataSize() const;
+
+private:
+    /** Number of partition lookaheads between exit checks.  Ranks can't
+     * get further apart than this. */
+    static const SimTime_t EXIT_CHECK_WINDOWS = 256;
+    static const int INIT_TAG = 1;
+    static const int SYNC_TAG = 3;
+
+    struct peer_t {
+        SyncQueue* squeue;
+        SimTime_t lookahead;    // minimum latency of the links to the peer
+        SimTime_t recv_bound;   // last bound received from the peer
+        SimTime_t send_bound;   // last bound sent to the peer
+        SyncQueue::Header null_hdr;
+        std::vector<Link*> links;   // by sync index
+#ifdef SST_CONFIG_HAVE_MPI
+        MPI_Request data_req;
+        MPI_Request null_req;
+#endif
+    };
+
+    typedef std::map<int, peer_t> peer_map_t;
+
+    /** Send the queued events to a peer along with a new bound */
+    void sendData(int rank, peer_t& peer, SimTime_t bound);
+    /** Send a header-only message carrying a new bound */
+    void sendNull(int rank, peer_t& peer, SimTime_t bound);
+    /** Receive every message that has arrived and deliver its events.
+     * Once this rank has finished the events are deleted instead. */
+    void receive();
+#ifdef SST_CONFIG_HAVE_MPI
+    /** Wait for a send to complete.  Messages keep being received
+     * meanwhile, so a peer waiting on its own sends can't block this
+     * rank. */
+    void waitSend(MPI_Request* req);
+#endif
+    /** Lowest bound over all peers.  A peer that has finished doesn't
+     * hold this rank back, but syncs still happen for the exit check. */
+    SimTime_t computeBound(SimTime_t current);
+
+    peer_map_t peers;
+
+    char* rbuf;
+    uint32_t rbuf_size;
+
+    Simulation* sim;
+    Exit* exit;
+    SimTime_t checkPeriod;
+    SimTime_t nextCheck;
+    bool finished;
+
+    uint64_t syncCount;
+    uint64_t dataMessages;
+    uint64_t nullMessages;
+    double mpiWaitTime;
+    double exitWaitTime;
+    double deserializeTime;
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_RANKSYNCNULLMESSAGE_H
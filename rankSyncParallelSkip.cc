@@ -41,9 +41,11 @@ RankSyncParallelSkip::RankSyncParallelSkip(RankInfo num_ranks, Core::ThreadSafe:
     minPartTC(minPartTC),
     mpiWaitTime(0.0),
     deserializeTime(0.0),
+    syncCount(0),
     send_count(0),
     barrier(barrier)
 {
+    num_threads = num_ranks.thread;
     // TraceFunction(CALL_INFO_LONG);
     max_period = Simulation::getSimulation()->getMinPartTC();
     myNextSyncTime = max_period->getFactor();
@@ -56,38 +58,43 @@ RankSyncParallelSkip::RankSyncParallelSkip(RankInfo num_ranks, Core::ThreadSafe:
 
 RankSyncParallelSkip::~RankSyncParallelSkip()
 {
+    double serializeTime = 0.0;
     for (auto i = comm_send_map.begin() ; i != comm_send_map.end() ; ++i) {
+        serializeTime += i->second.squeue->getSerializeTime();
         delete i->second.squeue;
     }
     comm_send_map.clear();
     
     for (auto i = comm_recv_map.begin() ; i != comm_recv_map.end() ; ++i) {
         delete[] i->second.rbuf;
+        for ( size_t j = 0; j < i->second.links.size(); j++ ) {
+            delete i->second.links[j];
+        }
     }
     comm_recv_map.clear();
-    
-    for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
-        delete i->second;
-    }
-    link_map.clear();
 
     delete[] recv_count;
     delete[] link_send_queue;
 
     if ( mpiWaitTime > 0.0 || deserializeTime > 0.0 )
         Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncParallelSkip mpiWait: %lg sec  deserializeWait:  %lg sec\n", mpiWaitTime, deserializeTime);
+    if ( syncCount > 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncParallelSkip %" PRIu64 " syncs  serialize: %lg sec (%lg usec/sync)  deserialize: %lg sec (%lg usec/sync)\n",
+                                           syncCount, serializeTime, 1e6 * serializeTime / syncCount,
+                                           deserializeTime, 1e6 * deserializeTime / syncCount);
 }
     
 ActivityQueue* RankSyncParallelSkip::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
 {
     // TraceFunction trace(CALL_INFO_LONG);
 
-    // For sends, we track the remote rank and thread ID
+    // For sends, we track the remote rank and thread ID.  Each local
+    // thread sending to it gets its own lane of the queue.
     SyncQueue* queue;
     if ( comm_send_map.count(to_rank) == 0 ) {
         send_count++;
         comm_send_map[to_rank].to_rank = to_rank;
-        queue = comm_send_map[to_rank].squeue = new SyncQueue();
+        queue = comm_send_map[to_rank].squeue = new SyncQueue(num_threads);
         comm_send_map[to_rank].remote_size = 4096;
     } else {
         queue = comm_send_map[to_rank].squeue;
@@ -103,22 +110,33 @@ ActivityQueue* RankSyncParallelSkip::registerLink(const RankInfo& to_rank, const
         comm_recv_map[remote_rank_local_thread].local_thread = from_rank.thread;
         comm_recv_map[remote_rank_local_thread].rbuf = new char[4096];
         comm_recv_map[remote_rank_local_thread].local_size = 4096;
+        comm_recv_map[remote_rank_local_thread].link_count.resize(num_threads, 0);
     }
-	
-    link_map[link_id] = link;
+
+    // Events from all the threads on the remote rank arrive in one
+    // message, so the index of a link interleaves the links to each
+    // remote thread.  The position of a link among the links between
+    // two threads is the same on both sides.
+    comm_recv_pair& recv = comm_recv_map[remote_rank_local_thread];
+    LinkId_t pos = recv.link_count[to_rank.thread]++;
+    size_t index = pos * num_threads + to_rank.thread;
+    if ( recv.links.size() <= index ) recv.links.resize(index + 1, NULL);
+    recv.links[index] = link;
+    setSyncIndex(link, pos * num_threads + from_rank.thread);
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     link->setSendingComponentInfo("SYNC", "SYNC", "");
 #endif
     // trace.getOutput().output(CALL_INFO,"queue = %p\n",queue);
-    return queue;
+    return queue->getLane(from_rank.thread);
 }
 
 void
 RankSyncParallelSkip::finalizeLinkConfigurations() {
     // TraceFunction trace(CALL_INFO_LONG);
-    for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
-        // i->second->finalizeConfiguration();
-        finalizeConfiguration(i->second);
+    for (comm_recv_map_t::iterator i = comm_recv_map.begin() ; i != comm_recv_map.end() ; ++i) {
+        for ( size_t j = 0; j < i->second.links.size(); j++ ) {
+            if ( i->second.links[j] != NULL ) finalizeConfiguration(i->second.links[j]);
+        }
     }
 
     // Set the size of the BoundedQueue that is the work queue for
@@ -200,18 +218,14 @@ RankSyncParallelSkip::exchange_slave(int thread)
             my_recv_count--;
 
             std::vector<Activity*>& activities = recv->activity_vec;
+            std::vector<Link*>& links = recv->links;
         
             for ( int i = 0; i < recv->activity_vec.size(); i++ ) {
                 Event* ev = static_cast<Event*>(recv->activity_vec[i]);
-                link_map_t::iterator link = link_map.find(ev->getLinkId());
-                if (link == link_map.end()) {
-                    printf("Link not found in map!\n");
-                    abort();
-                } else {
-                    // Need to figure out what the "delay" is for this event.
-                    SimTime_t delay = ev->getDeliveryTime() - current_cycle;
-                    link->second->send(delay,ev);
-                }
+                // Events carry the sync index of their link.  Need to
+                // figure out what the "delay" is for this event.
+                SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+                links[ev->getSyncIndex()]->send(delay,ev);
             }
             recv->activity_vec.clear();
         }
@@ -247,6 +261,7 @@ RankSyncParallelSkip::exchange_master(int thread)
     }    
 
     remaining_deser = comm_recv_map.size();
+    syncCount++;
     
     barrier.wait();
     
@@ -393,11 +408,19 @@ RankSyncParallelSkip::exchange_master(int thread)
     // all_reduce with min operator and set next sync time to be
     // min + max_period.
 
-    // Need to get the local minimum, then do a global minimum
+    // Need to get the local minimum, then do a global minimum.  The
+    // exit check is done in the same reduction.  Everything is reduced
+    // with MPI_MAX, so the time goes in as its distance below
+    // MAX_SIMTIME_T.
     // SimTime_t input = Simulation::getSimulation()->getNextActivityTime();
-    SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
-    SimTime_t min_time;
-    MPI_Allreduce( &input, &min_time, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD );
+    Exit* exit = Simulation::getSimulation()->getExit();
+    uint64_t input[3];
+    uint64_t output[3];
+    exit->getCheckInput(input);
+    input[2] = MAX_SIMTIME_T - Simulation::getLocalMinimumNextActivityTime();
+    MPI_Allreduce( input, output, 3, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    exit->setCheckResult(output);
+    SimTime_t min_time = MAX_SIMTIME_T - output[2];
 
     myNextSyncTime = min_time + max_period->getFactor();
     
@@ -487,23 +510,11 @@ RankSyncParallelSkip::exchangeLinkInitData(int thread, std::atomic<int>& msg_cou
             buffer = i->second.rbuf;
         }
 
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        
-        std::vector<Activity*> activities;
-        ser & activities;
-
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-            
-            Event* ev = static_cast<Event*>(activities[j]);
-            link_map_t::iterator link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
-                abort();
-            } else {
-                sendInitData_sync(link->second,ev);
-            }
-        }
+        std::vector<Link*>& links = i->second.links;
+        SyncQueue::unpackData(buffer, [&](Activity* activity) {
+            Event* ev = static_cast<Event*>(activity);
+            sendInitData_sync(links[ev->getSyncIndex()],ev);
+        });
         
         
         // for ( int j = 0; j < count; j++ ) {
@@ -548,19 +559,16 @@ RankSyncParallelSkip::exchangeLinkInitData(int thread, std::atomic<int>& msg_cou
 void
 RankSyncParallelSkip::deserializeMessage(comm_recv_pair* msg)
 {
-    char* buffer = msg->rbuf;
-    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
-    unsigned int size = hdr->buffer_size;
-    
-    auto deserialStart = SST::Core::Profile::now();
+    auto deserialStart = SyncQueue::now();
 
-    SST::Core::Serialization::serializer ser;
-    
-    
-    ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-    ser & msg->activity_vec;
+    // The events have to be sent on their links by the thread that
+    // owns them, so collect them in the (reused) activity_vec.
+    std::vector<Activity*>& activities = msg->activity_vec;
+    SyncQueue::unpackData(msg->rbuf, [&](Activity* activity) {
+        activities.push_back(activity);
+    });
 
-    deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
+    deserializeTime += SyncQueue::getElapsed(deserialStart);
 }
     
 
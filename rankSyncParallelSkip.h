@@ -17,6 +17,7 @@
 #include <sst/core/threadsafe.h>
 
 #include <map>
+#include <vector>
 
 #ifdef SST_CONFIG_HAVE_MPI
 #include <mpi.h>
@@ -42,6 +43,7 @@ public:
     void exchangeLinkInitData(int thread, std::atomic<int>& msg_count);
     /** Finish link configuration */
     void finalizeLinkConfigurations();
+    bool checksExit() { return true; }
 
     SimTime_t getNextSyncTime() { return myNextSyncTime; }
     
@@ -70,6 +72,8 @@ private:
         std::vector<Activity*> activity_vec;
         uint32_t local_size;
         bool recv_done;
+        std::vector<Link*> links;           // by sync index
+        std::vector<uint32_t> link_count;   // links to each remote thread
 #ifdef SST_CONFIG_HAVE_MPI
         MPI_Request req;
 #endif   
@@ -78,15 +82,15 @@ private:
     // typedef std::map<int, std::pair<SyncQueueC*, std::vector<char>* > > comm_map_t;
     typedef std::map<RankInfo, comm_send_pair > comm_send_map_t;
     typedef std::map<RankInfo, comm_recv_pair > comm_recv_map_t;
-    typedef std::map<LinkId_t, Link*> link_map_t;
 
     // TimeConverter* period;
     comm_send_map_t comm_send_map;
     comm_recv_map_t comm_recv_map;
-    link_map_t link_map;
+    uint32_t num_threads;
 
     double mpiWaitTime;
     double deserializeTime;
+    uint64_t syncCount;
 
     int* recv_count;
     int send_count;
@@ -154,31 +154,50 @@ RankSyncSerialSkip::getMasterAction()
 }
 #endif
     
-RankSyncSerialSkip::RankSyncSerialSkip(Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC) :
+RankSyncSerialSkip::RankSyncSerialSkip(Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC, bool async) :
     NewRankSync(),
     minPartTC(minPartTC),
     mpiWaitTime(0.0),
     deserializeTime(0.0),
+    syncCount(0),
+    async(async),
+    asyncPeriod(0),
+    asyncPending(false),
+    overlapTime(0.0),
     barrier(barrier)
 {
     max_period = Simulation::getSimulation()->getMinPartTC();
     myNextSyncTime = max_period->getFactor();
+
+    // In asynchronous mode, events sent during one window are not
+    // received until the end of the next, so each window can only be
+    // half the lookahead.
+    if ( async ) {
+        asyncPeriod = max_period->getFactor() / 2;
+        myNextSyncTime = asyncPeriod;
+    }
 }
 
 RankSyncSerialSkip::~RankSyncSerialSkip()
 {
+    double serializeTime = 0.0;
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        serializeTime += i->second.squeue->getSerializeTime();
         delete i->second.squeue;
+        for ( size_t j = 0; j < i->second.links.size(); j++ ) {
+            delete i->second.links[j];
+        }
     }
     comm_map.clear();
-    
-    for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
-        delete i->second;
-    }
-    link_map.clear();
 
     if ( mpiWaitTime > 0.0 || deserializeTime > 0.0 )
         Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncSerialSkip mpiWait: %lg sec  deserializeWait:  %lg sec\n", mpiWaitTime, deserializeTime);
+    if ( async )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncSerialSkip async mpiWait: %lg sec  overlapped: %lg sec\n", mpiWaitTime, overlapTime);
+    if ( syncCount > 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncSerialSkip %" PRIu64 " syncs  serialize: %lg sec (%lg usec/sync)  deserialize: %lg sec (%lg usec/sync)\n",
+                                           syncCount, serializeTime, 1e6 * serializeTime / syncCount,
+                                           deserializeTime, 1e6 * deserializeTime / syncCount);
 }
     
 ActivityQueue* RankSyncSerialSkip::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
@@ -194,7 +213,9 @@ ActivityQueue* RankSyncSerialSkip::registerLink(const RankInfo& to_rank, const R
         queue = comm_map[to_rank.rank].squeue;
     }
 	
-    link_map[link_id] = link;
+    std::vector<Link*>& links = comm_map[to_rank.rank].links;
+    setSyncIndex(link, links.size());
+    links.push_back(link);
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     link->setSendingComponentInfo("SYNC", "SYNC", "");
 #endif
@@ -205,9 +226,10 @@ ActivityQueue* RankSyncSerialSkip::registerLink(const RankInfo& to_rank, const R
 void
 RankSyncSerialSkip::finalizeLinkConfigurations() {
     // TraceFunction trace(CALL_INFO_LONG);
-    for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
-        // i->second->finalizeConfiguration();
-        finalizeConfiguration(i->second);
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        for ( size_t j = 0; j < i->second.links.size(); j++ ) {
+            finalizeConfiguration(i->second.links[j]);
+        }
     }
 }
 
@@ -224,23 +246,10 @@ RankSyncSerialSkip::getDataSize() const {
 void
 RankSyncSerialSkip::execute(int thread)
 {
-    if ( thread == 0 ) {
-        // totalWait += barrier.wait();
-        barrier.wait();
-        exchange();
-        // totalWait += barrier.wait();
-        barrier.wait();
-        // SimTime_t next = Simulation::getSimulation()->getCurrentSimCycle() + period->getFactor();
-        // Simulation::getSimulation()->insertActivity( next, this );
-    }
-    else {
-        // totalWait += barrier.wait();
-        // totalWait += barrier.wait();
-        barrier.wait();
-        barrier.wait();
-        // SimTime_t next = Simulation::getSimulation()->getCurrentSimCycle() + period->getFactor();
-        // Simulation::getSimulation()->insertActivity( next, this );
-    }
+    // Only used with one thread per rank, so there is nobody to wait
+    // for
+    if ( async ) exchangeAsync();
+    else exchange();
 }
 
 void
@@ -257,6 +266,7 @@ RankSyncSerialSkip::exchange(void)
     MPI_Request rreqs[comm_map.size()];
     int sreq_count = 0;
     int rreq_count = 0;
+    syncCount++;
     
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
         
@@ -294,70 +304,8 @@ RankSyncSerialSkip::exchange(void)
     auto waitStart = SST::Core::Profile::now();
     MPI_Waitall(rreq_count, rreqs, MPI_STATUSES_IGNORE);
     mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
-    
-    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
-        // Get the buffer and deserialize all the events
-        char* buffer = i->second.rbuf;
-        
-        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
-//            int count = hdr->count;
-        unsigned int size = hdr->buffer_size;
-        int mode = hdr->mode;
-        
-        if ( mode == 1 ) {
-            // May need to resize the buffer
-            if ( size > i->second.local_size ) {
-                delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
-            }
-            MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                     i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            buffer = i->second.rbuf;
-        }
-        
-        auto deserialStart = SST::Core::Profile::now();
-
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-
-        std::vector<Activity*> activities;
-        activities.clear();
-        ser & activities;
-        
-        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
-
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-            
-            Event* ev = static_cast<Event*>(activities[j]);
-            link_map_t::iterator link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
-                abort();
-            } else {
-                // Need to figure out what the "delay" is for this event.
-                SimTime_t delay = ev->getDeliveryTime() - current_cycle;
-                link->second->send(delay,ev);
-            }
-        }
 
-        activities.clear();
-
-        // for ( int j = 0; j < count; j++ ) {
-        //     Event* ev;
-        //     ia >> ev;
-        
-        //     link_map_t::iterator link = link_map.find(ev->getLinkId());
-        //     if (link == link_map.end()) {
-        //         printf("Link not found in map!\n");
-        //         abort();
-        //     } else {
-        //         // Need to figure out what the "delay" is for this event.
-        //         SimTime_t delay = ev->getDeliveryTime() - current_cycle;
-        //         link->second->send(delay,ev);
-        //     }
-        // }
-    }
+    deliverEvents(current_cycle);
 
     // Clear the SyncQueues used to send the data after all the sends have completed
     waitStart = SST::Core::Profile::now();
@@ -375,11 +323,19 @@ RankSyncSerialSkip::exchange(void)
     // all_reduce with min operator and set next sync time to be
     // min + max_period.
 
-    // Need to get the local minimum, then do a global minimum
+    // Need to get the local minimum, then do a global minimum.  The
+    // exit check is done in the same reduction.  Everything is reduced
+    // with MPI_MAX, so the time goes in as its distance below
+    // MAX_SIMTIME_T.
     // SimTime_t input = Simulation::getSimulation()->getNextActivityTime();
-    SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
-    SimTime_t min_time;
-    MPI_Allreduce( &input, &min_time, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD );
+    Exit* exit = Simulation::getSimulation()->getExit();
+    uint64_t input[3];
+    uint64_t output[3];
+    exit->getCheckInput(input);
+    input[2] = MAX_SIMTIME_T - Simulation::getLocalMinimumNextActivityTime();
+    MPI_Allreduce( input, output, 3, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    exit->setCheckResult(output);
+    SimTime_t min_time = MAX_SIMTIME_T - output[2];
 
     myNextSyncTime = min_time + max_period->getFactor();
     
@@ -390,6 +346,141 @@ RankSyncSerialSkip::exchange(void)
 #endif
 }
 
+void
+RankSyncSerialSkip::exchangeAsync(void)
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    syncCount++;
+
+    Simulation* sim = Simulation::getSimulation();
+    SimTime_t current_cycle = sim->getCurrentSimCycle();
+
+    if ( asyncPending ) {
+        // Finish the exchange posted at the last sync.  Those events
+        // can't be delivered before the end of this window, which is
+        // now.  Any part of the transfer that finished while the
+        // window was being simulated was hidden.
+        auto waitStart = SST::Core::Profile::now();
+        MPI_Waitall(async_rreqs.size(), async_rreqs.data(), MPI_STATUSES_IGNORE);
+        MPI_Waitall(async_sreqs.size(), async_sreqs.data(), MPI_STATUSES_IGNORE);
+        double wait = SST::Core::Profile::getElapsed(waitStart);
+        mpiWaitTime += wait;
+        overlapTime += SST::Core::Profile::getElapsed(asyncPostTime) - wait;
+
+        deliverEvents(current_cycle);
+    }
+
+    // Post the exchange for the window that just ended.  The
+    // SyncQueues switch to their other buffer, so events sent during
+    // the next window don't touch the data in flight.
+    async_sreqs.clear();
+    async_rreqs.clear();
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        char* send_buffer = i->second.squeue->getData();
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
+        int tag = 1;
+        // Check to see if remote queue is big enough for data
+        if ( i->second.remote_size < hdr->buffer_size ) {
+            // not big enough, send message that will tell remote side to get larger buffer
+            hdr->mode = 1;
+            async_sreqs.push_back(MPI_Request());
+            MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
+                      i->first/*dest*/, tag, MPI_COMM_WORLD, &async_sreqs.back());
+            i->second.remote_size = hdr->buffer_size;
+            tag = 2;
+        }
+        else {
+            hdr->mode = 0;
+        }
+        async_sreqs.push_back(MPI_Request());
+        MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE,
+                  i->first/*dest*/, tag, MPI_COMM_WORLD, &async_sreqs.back());
+        i->second.squeue->swapBuffers();
+
+        async_rreqs.push_back(MPI_Request());
+        MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE,
+                  i->first, 1, MPI_COMM_WORLD, &async_rreqs.back());
+    }
+    asyncPostTime = SST::Core::Profile::now();
+    asyncPending = true;
+
+    // No skipping ahead: that would need a blocking reduction, which
+    // is what this mode avoids.
+    myNextSyncTime = current_cycle + asyncPeriod;
+#endif
+}
+
+char*
+RankSyncSerialSkip::completeRecv(comm_map_t::iterator i)
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    char* buffer = i->second.rbuf;
+
+    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+    unsigned int size = hdr->buffer_size;
+    int mode = hdr->mode;
+
+    if ( mode == 1 ) {
+        // May need to resize the buffer
+        if ( size > i->second.local_size ) {
+            delete[] i->second.rbuf;
+            i->second.rbuf = new char[size];
+            i->second.local_size = size;
+        }
+        auto waitStart = SST::Core::Profile::now();
+        MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
+                 i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+        buffer = i->second.rbuf;
+    }
+    return buffer;
+#else
+    return NULL;
+#endif
+}
+
+void
+RankSyncSerialSkip::deliverEvents(SimTime_t current_cycle)
+{
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        // Get the buffer and deserialize all the events
+        char* buffer = completeRecv(i);
+
+        // Events are delivered as they are unpacked, so this times
+        // deserialization and delivery together.
+        auto deserialStart = SyncQueue::now();
+
+        std::vector<Link*>& links = i->second.links;
+        SyncQueue::unpackData(buffer, [&](Activity* activity) {
+            Event* ev = static_cast<Event*>(activity);
+            // Events carry the sync index of their link.  Need to
+            // figure out what the "delay" is for this event.
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            links[ev->getSyncIndex()]->send(delay,ev);
+        });
+
+        deserializeTime += SyncQueue::getElapsed(deserialStart);
+    }
+}
+
+void
+RankSyncSerialSkip::finish()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( !asyncPending ) return;
+
+    // Every rank posted the same last exchange, so this can't block
+    // forever.  The events are past the end of the simulation and are
+    // dropped.
+    MPI_Waitall(async_rreqs.size(), async_rreqs.data(), MPI_STATUSES_IGNORE);
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        completeRecv(i);
+    }
+    MPI_Waitall(async_sreqs.size(), async_sreqs.data(), MPI_STATUSES_IGNORE);
+    asyncPending = false;
+#endif
+}
+
 void
 RankSyncSerialSkip::exchangeLinkInitData(int thread, std::atomic<int>& msg_count)
 {
@@ -461,22 +552,11 @@ RankSyncSerialSkip::exchangeLinkInitData(int thread, std::atomic<int>& msg_count
             buffer = i->second.rbuf;
         }
         
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        
-        std::vector<Activity*> activities;
-        ser & activities;
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-            
-            Event* ev = static_cast<Event*>(activities[j]);
-            link_map_t::iterator link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
-                abort();
-            } else {
-                sendInitData_sync(link->second,ev);
-            }
-        }
+        std::vector<Link*>& links = i->second.links;
+        SyncQueue::unpackData(buffer, [&](Activity* activity) {
+            Event* ev = static_cast<Event*>(activity);
+            sendInitData_sync(links[ev->getSyncIndex()],ev);
+        });
         
         
         // for ( int j = 0; j < count; j++ ) {
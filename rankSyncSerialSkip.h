@@ -17,6 +17,13 @@
 #include <sst/core/threadsafe.h>
 
 #include <map>
+#include <vector>
+
+#ifdef SST_CONFIG_HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <sst/core/profile.h>
 
 namespace SST {
 
@@ -27,7 +34,10 @@ class RankSyncSerialSkip : public NewRankSync {
 public:
     /** Create a new Sync object which fires with a specified period */
     // Sync(TimeConverter* period);
-    RankSyncSerialSkip(Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC);
+    /**
+     * @param async - overlap the exchange with simulation (see exchangeAsync())
+     */
+    RankSyncSerialSkip(Core::ThreadSafe::Barrier& barrier, TimeConverter* minPartTC, bool async = false);
     virtual ~RankSyncSerialSkip();
     
     /** Register a Link which this Sync Object is responsible for */
@@ -38,6 +48,9 @@ public:
     void exchangeLinkInitData(int thread, std::atomic<int>& msg_count);
     /** Finish link configuration */
     void finalizeLinkConfigurations();
+    /** Complete an exchange left in flight by exchangeAsync() */
+    void finish();
+    bool checksExit() { return !async; }
 
     SimTime_t getNextSyncTime() { return myNextSyncTime; }
     
@@ -50,24 +63,43 @@ private:
     
     // Function that actually does the exchange during run
     void exchange();
+    // Exchange used in asynchronous mode.  The sends and receives
+    // posted at one sync are completed at the next one.
+    void exchangeAsync();
+    // Deliver the events in the receive buffers
+    void deliverEvents(SimTime_t current_cycle);
     
     struct comm_pair {
         SyncQueue* squeue; // SyncQueue
         char* rbuf; // receive buffer
         uint32_t local_size;
         uint32_t remote_size;
+        std::vector<Link*> links; // by sync index
     };
     
     // typedef std::map<int, std::pair<SyncQueueC*, std::vector<char>* > > comm_map_t;
     typedef std::map<int, comm_pair > comm_map_t;
-    typedef std::map<LinkId_t, Link*> link_map_t;
+
+    // Finish receiving into a peer's buffer, fetching the full data
+    // if only a Header was sent.  Returns the buffer.
+    char* completeRecv(comm_map_t::iterator i);
 
     // TimeConverter* period;
     comm_map_t comm_map;
-    link_map_t link_map;
 
     double mpiWaitTime;
     double deserializeTime;
+    uint64_t syncCount;
+
+    bool async;
+    SimTime_t asyncPeriod;
+    bool asyncPending;
+    double overlapTime;
+    Core::Profile::ProfData_t asyncPostTime;
+#ifdef SST_CONFIG_HAVE_MPI
+    std::vector<MPI_Request> async_sreqs;
+    std::vector<MPI_Request> async_rreqs;
+#endif
 
     Core::ThreadSafe::Barrier& barrier;
 
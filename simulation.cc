@@ -14,6 +14,7 @@
 #include "sst/core/serialization.h"
 #include <sst/core/simulation.h>
 
+#include <chrono>
 #include <utility>
 
 #include <boost/foreach.hpp>
@@ -32,12 +33,15 @@
 #include <sst/core/linkPair.h>
 #include <sst/core/sharedRegionImpl.h>
 #include <sst/core/output.h>
+#include <sst/core/part/profile.h>
+#include <sst/core/pollingLinkQueue.h>
 #include <sst/core/stopAction.h>
 #include <sst/core/stringize.h>
 #include <sst/core/rankSync.h>
 #include <sst/core/sync.h>
 #include <sst/core/syncManager.h>
 #include <sst/core/syncQueue.h>
+#include <sst/core/threadLoadBalancer.h>
 #include <sst/core/threadSync.h>
 #include <sst/core/timeLord.h>
 #include <sst/core/timeVortex.h>
@@ -141,6 +145,12 @@ void Simulation::shutdown()
 Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks, SimTime_t min_part) :
     runMode(cfg->runMode),
     timeVortex(NULL),
+    batchDispatch(cfg->batch_dispatch),
+    linkFifo(cfg->link_fifo),
+    asyncRankSync(cfg->async_rank_sync),
+    pairwiseThreadSync(cfg->pairwise_thread_sync),
+    nullMessageSync(cfg->null_message_sync),
+    loadBalance(cfg->load_balance),
     interThreadMinLatency(MAX_SIMTIME_T),
     threadSync(NULL),
     currentSimCycle(0),
@@ -152,7 +162,8 @@ Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks, SimTi
     init_phase(0),
     lastRecvdSignal(0),
     shutdown_mode(SHUTDOWN_CLEAN),
-    wireUpFinished(false)
+    wireUpFinished(false),
+    checkpoint_checked(false)
 {
     sim_output.init(cfg->output_core_prefix, cfg->getVerboseLevel(), 0, Output::STDOUT);
     output_directory = "";
@@ -160,12 +171,17 @@ Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks, SimTi
     // Create the Statistic Processing Engine
     statisticsEngine = new StatisticProcessingEngine();
 
-    timeVortex = new TimeVortex;
+    timeVortex = TimeVortex::getTimeVortex(cfg->timeVortex);
+    if ( timeVortex == NULL ) {
+        sim_output.fatal(CALL_INFO, 1, "Unknown TimeVortex type: %s\n", cfg->timeVortex.c_str());
+    }
     if( my_rank.thread == 0 ) {
         // m_exit = new Exit( num_ranks.thread, timeLord.getTimeConverter("100ns"), num_ranks.rank == 1 );
         m_exit = new Exit( num_ranks.thread, timeLord.getTimeConverter("100ns"), min_part == MAX_SIMTIME_T );
     }
 
+    optimisticWindow = timeLord.getSimCycles(cfg->optimisticWindow, "optimistic window");
+
     if(strcmp(cfg->heartbeatPeriod.c_str(), "N") != 0 && my_rank.thread == 0) {
         sim_output.output("# Creating simulation heartbeat at period of %s.\n", cfg->heartbeatPeriod.c_str());
     	m_heartbeat = new SimulatorHeartbeat(cfg, my_rank.rank, this, timeLord.getTimeConverter(cfg->heartbeatPeriod) );
@@ -216,9 +232,166 @@ Simulation::requireEvent(std::string name)
 SimTime_t
 Simulation::getNextActivityTime() const
 {
+    if ( timeVortex->empty() ) return MAX_SIMTIME_T;
     return timeVortex->front()->getDeliveryTime();
 }
 
+void
+Simulation::checkCheckpointSupport()
+{
+    // Statistics written to the StatisticOutput can't be taken back
+    if ( statisticsEngine->hasOutputDuringRun() ) {
+        checkpoint_problem = "statistics are output before the end of the simulation";
+        return;
+    }
+
+    // Polling links hold their events outside the TimeVortex
+    for ( auto iter = compInfoMap.begin(); iter != compInfoMap.end(); ++iter ) {
+        if ( (*iter)->getLinkMap() == NULL ) continue;
+        std::map<std::string, Link*>& link_map = (*iter)->getLinkMap()->getLinkMap();
+        for ( auto link = link_map.begin(); link != link_map.end(); ++link ) {
+            if ( dynamic_cast<PollingLinkQueue*>(link->second->recvQueue) != NULL ) {
+                checkpoint_problem = "component " + (*iter)->getName() + " has a polling link";
+                return;
+            }
+        }
+    }
+}
+
+Simulation::CheckpointResult_t
+Simulation::saveCheckpoint(SimTime_t until)
+{
+    if ( !checkpoint_checked ) {
+        checkCheckpointSupport();
+        checkpoint_checked = true;
+    }
+    if ( !checkpoint_problem.empty() ) return CHECKPOINT_UNSUPPORTED;
+
+    CheckpointResult_t result = CHECKPOINT_OK;
+    checkpoint_time = currentSimCycle;
+    checkpoint_priority = currentPriority;
+    checkpoint_entries.clear();
+    checkpoint_events.clear();
+
+    // The TimeVortex can only be read by popping it, so take
+    // everything out, copy the Events and note where the Actions
+    // were, then put it all back with the same order
+    std::vector<Activity*> pending;
+    while ( !timeVortex->empty() ) {
+        pending.push_back(timeVortex->pop());
+    }
+
+    Core::Serialization::serializer ser;
+    for ( size_t i = 0; i < pending.size(); i++ ) {
+        Activity* activity = pending[i];
+        checkpoint_entry_t entry;
+        entry.time = activity->getDeliveryTime();
+        entry.order = activity->getQueueOrder();
+
+        Event* ev = dynamic_cast<Event*>(activity);
+        if ( ev != NULL ) {
+            // A type without serialization of its own would be saved
+            // as its parent type
+            if ( checkpoint_types.insert(std::type_index(typeid(*ev))).second &&
+                 !Core::Serialization::serializable_factory::sanity(ev, ev->cls_id()) ) {
+                sim_output.fatal(CALL_INFO, 1, "Event type %s can't be saved for --optimistic-window.  "
+                                 "Every Event type sent on a link must use ImplementSerializable itself.\n",
+                                 typeid(*ev).name());
+            }
+            entry.activity = NULL;
+            entry.link = ev->getDeliveryLink();
+            entry.offset = checkpoint_events.size();
+            ser.start_sizing();
+            ser & activity;
+            entry.size = ser.size();
+            checkpoint_events.resize(entry.offset + entry.size);
+            ser.start_packing(&checkpoint_events[entry.offset], entry.size);
+            ser & activity;
+        }
+        else {
+            entry.activity = activity;
+            entry.link = NULL;
+            entry.offset = 0;
+            entry.size = 0;
+            // A stop ends the run loop before the window can be
+            // checked
+            if ( dynamic_cast<StopAction*>(activity) != NULL && entry.time <= until ) {
+                result = CHECKPOINT_STOP;
+            }
+        }
+        checkpoint_entries.push_back(entry);
+        timeVortex->insertOrdered(activity);
+    }
+
+    for ( auto && clock : clockMap ) {
+        clock.second->saveCheckpoint();
+    }
+    for ( auto && oneShot : oneShotMap ) {
+        oneShot.second->saveCheckpoint();
+    }
+    for ( auto iter = compInfoMap.begin(); iter != compInfoMap.end(); ++iter ) {
+        if ( !(*iter)->getComponent()->saveCheckpoint() ) {
+            checkpoint_problem = "component " + (*iter)->getName() + " doesn't implement saveCheckpoint()";
+            result = CHECKPOINT_UNSUPPORTED;
+        }
+    }
+    return result;
+}
+
+void
+Simulation::restoreCheckpoint()
+{
+    // Everything in the TimeVortex was either scheduled during the
+    // window or is in the checkpoint.  Events are owned by the
+    // TimeVortex; Actions are put back from the checkpoint.
+    while ( !timeVortex->empty() ) {
+        Activity* activity = timeVortex->pop();
+        if ( dynamic_cast<Event*>(activity) != NULL ) delete activity;
+    }
+
+    currentSimCycle = checkpoint_time;
+    currentPriority = checkpoint_priority;
+
+    Core::Serialization::serializer ser;
+    for ( size_t i = 0; i < checkpoint_entries.size(); i++ ) {
+        checkpoint_entry_t& entry = checkpoint_entries[i];
+        Activity* activity;
+        if ( entry.size > 0 ) {
+            activity = NULL;
+            ser.start_unpacking(&checkpoint_events[entry.offset], entry.size);
+            ser & activity;
+            Event* ev = static_cast<Event*>(activity);
+            ev->setDeliveryLink(ev->getLinkId(), entry.link);
+        }
+        else {
+            activity = entry.activity;
+            activity->setDeliveryTime(entry.time);
+            activity->setQueueOrder(entry.order);
+        }
+        timeVortex->insertOrdered(activity);
+    }
+
+    for ( auto && clock : clockMap ) {
+        clock.second->restoreCheckpoint();
+    }
+    for ( auto && oneShot : oneShotMap ) {
+        oneShot.second->restoreCheckpoint();
+    }
+    for ( auto iter = compInfoMap.begin(); iter != compInfoMap.end(); ++iter ) {
+        (*iter)->getComponent()->restoreCheckpoint();
+    }
+}
+
+void
+Simulation::discardCheckpoint()
+{
+    for ( auto iter = compInfoMap.begin(); iter != compInfoMap.end(); ++iter ) {
+        (*iter)->getComponent()->discardCheckpoint();
+    }
+    checkpoint_entries.clear();
+    checkpoint_events.clear();
+}
+
 SimTime_t
 Simulation::getLocalMinimumNextActivityTime()
 {
@@ -234,7 +407,7 @@ Simulation::getLocalMinimumNextActivityTime()
 }
 
 void
-Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& myRank, SimTime_t min_part )
+Simulation::processGraphInfo( ConfigGraph& graph, const ConfigGraphThreadIndex& index, const RankInfo& myRank, SimTime_t min_part )
 {
     // TraceFunction trace(CALL_INFO_LONG);    
     // Set minPartTC (only thread 0 will do this)
@@ -249,51 +422,30 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& myRank, SimTim
         interThreadLatencies[i] = MAX_SIMTIME_T;
     }
 
-    interThreadMinLatency = MAX_SIMTIME_T;
-    int cross_thread_links = 0;
+    // The rank wide values were found when the index was built, so
+    // only the links on this thread need to be looked at here
+    interThreadMinLatency = index.getInterThreadMinLatency();
+    uint64_t cross_thread_links = index.getNumCrossThreadLinks();
     if ( num_ranks.thread > 1 ) {
-        // Need to determine the lookahead for the thread synchronization
-        ConfigComponentMap_t comps = graph.getComponentMap();
-        ConfigLinkMap_t links = graph.getLinkMap();
-        // Find the minimum latency across a partition
-        for ( auto iter = links.begin(); iter != links.end(); ++iter ) {
-            ConfigLink &clink = *iter;
+        const std::vector<ConfigLink*>& links = index.getLinks(my_rank.thread);
+        for ( size_t i = 0; i < links.size(); i++ ) {
+            ConfigLink &clink = *links[i];
             RankInfo rank[2];
-            rank[0] = comps[clink.component[0]].rank;
-            rank[1] = comps[clink.component[1]].rank;
-            // We only care about links that are on my rank, but
-            // different threads
-
-            // Neither endpoint is on my rank
-            if ( rank[0].rank != my_rank.rank && rank[1].rank != my_rank.rank ) continue;
-            // Rank and thread are the same
+            rank[0] = graph.comps[clink.component[0]].rank;
+            rank[1] = graph.comps[clink.component[1]].rank;
+            // Only links to other threads on this rank matter
             if ( rank[0] == rank[1] ) continue;
-            // Different ranks, so doesn't affect interthread dependencies
             if ( rank[0].rank != rank[1].rank ) continue;
 
-            // At this point, we know that both endpoints are on this
-            // rank, but on diffrent threads.  Therefore, they
-            // contribute to the interThreadMinLatency.
-            cross_thread_links++;
-            if ( clink.getMinLatency() < interThreadMinLatency ) {
-                interThreadMinLatency = clink.getMinLatency();
-            }
-
-            // Now check only those latencies that directly impact this
-            // thread.  Keep track of minimum latency for each other
-            // thread separately
-            if ( rank[0].thread == my_rank.thread) { 
-                if ( clink.getMinLatency() < interThreadLatencies[rank[1].thread] ) {
-                    interThreadLatencies[rank[1].thread] = clink.getMinLatency();
-                }
-            }
-            else if ( rank[1].thread == my_rank.thread ) {
-                if ( clink.getMinLatency() < interThreadLatencies[rank[0].thread] ) {
-                    interThreadLatencies[rank[0].thread] = clink.getMinLatency();
-                }
+            // Keep track of minimum latency for each other thread
+            // separately
+            int remote = ( rank[0].thread == my_rank.thread ) ? rank[1].thread : rank[0].thread;
+            if ( clink.getMinLatency() < interThreadLatencies[remote] ) {
+                interThreadLatencies[remote] = clink.getMinLatency();
             }
         }
     }
+
     // Create the SyncManager for this rank.  It gets created even if
     // we are single rank/single thread because it also manages the
     // Exit and Heartbeat actions.
@@ -316,15 +468,12 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& myRank, SimTim
     // if ( independent ) std::cout << "thread " << my_rank.thread <<  " is independent" << std::endl;
 }
     
-int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTime_t min_part )
+int Simulation::performWireUp( ConfigGraph& graph, const ConfigGraphThreadIndex& index, const RankInfo& myRank, SimTime_t min_part )
 {
     // TraceFunction trace(CALL_INFO_LONG);    
     
     // Create the Statistics Output
 
-    // Params objects should now start verifying parameters
-    Params::enableVerify();
-
     // Need to create the sync objects.  There are two versions, one
     // that synchronizes between threads and one that synchronizes
     // between MPI ranks.
@@ -388,16 +537,20 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
     }
 #endif
     
+    // All the threads wire up at the same time.  Each one only looks
+    // at its own part of the graph, and anything shared (the Factory,
+    // TimeLord, statistics output and the rank sync) is locked.
+    const std::vector<ConfigComponent*>& my_comps = index.getComponents(myRank.thread);
+    const std::vector<ConfigLink*>& my_links = index.getLinks(myRank.thread);
+
     // First, go through all the components that are in this rank and
     // create the ComponentInfo object for it
-    // Now, build all the components
-    for ( ConfigComponentMap_t::iterator iter = graph.comps.begin();
-            iter != graph.comps.end(); ++iter )
-    {
-        ConfigComponent* ccomp = &(*iter);
+    for ( size_t i = 0; i < my_comps.size(); i++ ) {
+        ConfigComponent* ccomp = my_comps[i];
         if ( ccomp->rank == myRank ) {
             // compInfoMap[ccomp->id] = ComponentInfo(ccomp->name, ccomp->type, new LinkMap());
             compInfoMap.insert(new ComponentInfo(ccomp->id, ccomp->name, ccomp->type, new LinkMap()));
+            if ( loadBalancer != NULL ) loadBalancer->addComponent(ccomp->id, myRank.thread);
         }
     }
     
@@ -405,20 +558,14 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
     // We will go through all the links and create LinkPairs for each
     // link.  We will also create a LinkMap for each component and put
     // them into a map with ComponentID as the key.
-    for( ConfigLinkMap_t::iterator iter = graph.links.begin();
-            iter != graph.links.end(); ++iter )
-    {
-        ConfigLink &clink = *iter;
+    for ( size_t i = 0; i < my_links.size(); i++ ) {
+        ConfigLink &clink = *my_links[i];
         RankInfo rank[2];
         rank[0] = graph.comps[clink.component[0]].rank;
         rank[1] = graph.comps[clink.component[1]].rank;
 
-        if ( rank[0] != myRank && rank[1] != myRank ) {
-            // Nothing to be done
-            continue;
-        }
         // Same rank, same thread
-        else if ( rank[0] == rank[1] ) {
+        if ( rank[0] == rank[1] ) {
             // Create a LinkPair to represent this link
             LinkPair lp(clink.id);
 
@@ -439,7 +586,10 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
                 sim_output.fatal(CALL_INFO,1,"Couldn't find ComponentInfo in map.");
             }
             cinfo->getLinkMap()->insertLink(clink.port[1],lp.getRight());
-
+            if ( loadBalancer != NULL ) {
+                loadBalancer->addLink(clink.id, 0, clink.component[0], myRank.thread, lp.getLeft(), NULL);
+                loadBalancer->addLink(clink.id, 1, clink.component[1], myRank.thread, lp.getRight(), NULL);
+            }
         }
         // If the components are not in the same thread, then the
         // SyncManager will handle things
@@ -478,6 +628,12 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
 
             lp.getRight()->configuredQueue = sync_q;
             lp.getRight()->initQueue = sync_q;
+
+            // Links to other ranks are recorded too, so the balancer
+            // knows not to move their components
+            if ( loadBalancer != NULL ) {
+                loadBalancer->addLink(clink.id, local, clink.component[local], myRank.thread, lp.getLeft(), lp.getRight());
+            }
         }
 
 /*        
@@ -565,9 +721,8 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
 //    graph.links.clear();
 
     // Now, build all the components
-    for ( auto iter = graph.comps.begin(); iter != graph.comps.end(); ++iter )
-    {
-        ConfigComponent* ccomp = &(*iter);
+    for ( size_t i = 0; i < my_comps.size(); i++ ) {
+        ConfigComponent* ccomp = my_comps[i];
 
         if (ccomp->isIntrospector) {
             Introspector* tmp;
@@ -723,12 +878,35 @@ void Simulation::run() {
     header += SST::to_string(my_rank.thread);
     header += ":  ";
     // wait_my_turn_end(barrier, my_rank.thread, num_ranks.thread);
+    std::vector<Activity*> batch;
     while( LIKELY( ! endSim ) ) {
-        currentSimCycle = timeVortex->front()->getDeliveryTime();
-        currentPriority = timeVortex->front()->getPriority();
-        current_activity = timeVortex->pop();
-        //current_activity->print(header, sim_output);
-        current_activity->execute();
+        if ( !batchDispatch ) {
+            currentSimCycle = timeVortex->front()->getDeliveryTime();
+            currentPriority = timeVortex->front()->getPriority();
+            current_activity = timeVortex->pop();
+            //current_activity->print(header, sim_output);
+            current_activity->execute();
+        }
+        else {
+            // Everything in the batch has the same time and priority,
+            // so the clock only needs to be set once.  If the batch
+            // ends the simulation, or an activity schedules something
+            // that has to be delivered between two batch entries, the
+            // rest of the batch goes back into the TimeVortex.
+            timeVortex->popBatch(batch);
+            currentSimCycle = batch[0]->getDeliveryTime();
+            currentPriority = batch[0]->getPriority();
+            for ( size_t i = 0; i < batch.size(); i++ ) {
+                current_activity = batch[i];
+                current_activity->execute();
+                if ( UNLIKELY( endSim || timeVortex->batchConflict() ) && i + 1 < batch.size() ) {
+                    timeVortex->returnBatch(batch, i + 1);
+                    break;
+                }
+            }
+            timeVortex->closeBatch();
+            batch.clear();
+        }
 
 
         if ( UNLIKELY( 0 != lastRecvdSignal ) ) {
@@ -753,6 +931,10 @@ void Simulation::run() {
     /* We shouldn't need to do this, but to be safe... */
     ThreadSync::disable();
 
+    // Must come before the barrier, since other threads may still be
+    // waiting on this one in the thread sync
+    syncManager->finish();
+
     // fprintf(stderr, "thread %u waiting on runLoop finish barrier\n", my_rank.thread);
     barrier.wait();  // TODO<- Is this needed?
     // fprintf(stderr, "thread %u released from runLoop finish barrier\n", my_rank.thread);
@@ -928,6 +1110,64 @@ TimeConverter* Simulation::registerClock(const UnitAlgebra& freq, Clock::Handler
     return tcFreq;
 }
 
+void Simulation::setClockHandlerOwner(Clock::HandlerBase* handler, ComponentId_t id)
+{
+    // New entries start with zero counts
+    clockProfile[handler].owner = id;
+}
+
+bool Simulation::executeProfiled(Clock::HandlerBase* handler, Cycle_t cycle)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool done = (*handler)(cycle);
+    double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::unordered_map<Clock::HandlerBase*, clock_profile_t>::iterator entry = clockProfile.find(handler);
+    if ( entry != clockProfile.end() ) {
+        entry->second.calls++;
+        entry->second.time += time;
+    }
+    return done;
+}
+
+void Simulation::collectProfile(Partition::PartitionProfile& profile) const
+{
+    // Events are counted on the receiving side of each link, which
+    // is the side in the receiving component's LinkMap
+    std::map<ComponentId_t, std::pair<uint64_t, double> > counts;
+    for ( ComponentInfoMap::const_iterator it = compInfoMap.begin(); it != compInfoMap.end(); ++it ) {
+        std::pair<uint64_t, double>& count = counts[(*it)->getID()];
+        LinkMap* link_map = (*it)->getLinkMap();
+        if ( link_map == NULL ) continue;
+        std::map<std::string, Link*>& links = link_map->getLinkMap();
+        for ( std::map<std::string, Link*>::iterator link = links.begin(); link != links.end(); ++link ) {
+            count.first += link->second->getProfileEvents();
+            count.second += link->second->getProfileTime();
+            // Links made by the component itself have no ID
+            if ( link->second->getId() == (LinkId_t)-1 ) continue;
+            profile.addLink(link->second->getId(), link->second->getProfileEvents());
+        }
+    }
+
+    for ( std::unordered_map<Clock::HandlerBase*, clock_profile_t>::const_iterator it = clockProfile.begin();
+          it != clockProfile.end(); ++it ) {
+        std::pair<uint64_t, double>& count = counts[it->second.owner];
+        count.first += it->second.calls;
+        count.second += it->second.time;
+    }
+
+    for ( std::map<ComponentId_t, std::pair<uint64_t, double> >::iterator it = counts.begin(); it != counts.end(); ++it ) {
+        ComponentInfo* info = compInfoMap.getByID(it->first);
+        if ( info == NULL ) continue;
+        profile.addComponent(it->first, info->getName(), it->second.first, it->second.second);
+    }
+}
+
+void Simulation::pinComponent(ComponentId_t id)
+{
+    if ( loadBalancer != NULL ) loadBalancer->pin(id);
+}
+
 Cycle_t Simulation::reregisterClock( TimeConverter* tc, Clock::HandlerBase* handler )
 {
     if ( clockMap.find( tc->getFactor() ) == clockMap.end() ) {
@@ -1090,6 +1330,8 @@ Output Simulation::sim_output;
 Core::ThreadSafe::Barrier Simulation::barrier;
 Core::ThreadSafe::Barrier Simulation::exit_barrier;
 std::mutex Simulation::simulationMutex;
+bool Simulation::profiling = false;
+ThreadLoadBalancer* Simulation::loadBalancer = NULL;
 TimeConverter* Simulation::minPartTC = NULL;
 SimTime_t Simulation::minPart;
 SyncBase* Simulation::sync = NULL;
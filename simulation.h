@@ -22,7 +22,9 @@
 #include <iostream>
 #include <thread>
 
+#include <typeindex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <sst/core/output.h>
 #include <sst/core/clock.h>
@@ -45,11 +47,13 @@ class Activity;
 class Component;
 class Config;
 class ConfigGraph;
+class ConfigGraphThreadIndex;
 class Exit;
 class Factory;
 class SimulatorHeartbeat;
 //class Graph;
 class Introspector;
+class Link;
 class LinkMap;
 class Params;
 class SyncBase;
@@ -57,6 +61,7 @@ class SyncManager;
 class ThreadSync;
 class TimeConverter;
 class TimeLord;
+class ThreadLoadBalancer;
 class TimeVortex;
 class UnitAlgebra;
 class SharedRegionManager;
@@ -64,6 +69,9 @@ namespace Statistics {
     class StatisticOutput;
     class StatisticProcessingEngine;
 }
+namespace Partition {
+    class PartitionProfile;
+}
 
 
 typedef std::map<std::string, Introspector* > IntroMap_t;
@@ -116,10 +124,12 @@ public:
     /** Processes the ConfigGraph to pull out any need information
      * about relationships among the threads
      */
-    void processGraphInfo( ConfigGraph& graph, const RankInfo &myRank, SimTime_t min_part );
+    void processGraphInfo( ConfigGraph& graph, const ConfigGraphThreadIndex& index, const RankInfo &myRank, SimTime_t min_part );
 
-    /** Converts a ConfigGraph graph into actual set of links and components */
-    int performWireUp( ConfigGraph& graph, const RankInfo &myRank, SimTime_t min_part );
+    /** Converts a ConfigGraph graph into actual set of links and
+     * components.  All the threads of a rank can do this at the same
+     * time. */
+    int performWireUp( ConfigGraph& graph, const ConfigGraphThreadIndex& index, const RankInfo &myRank, SimTime_t min_part );
 
     /** Set cycle count, which, if reached, will cause the simulation to halt. */
     void setStopAtCycle( Config* cfg );
@@ -176,6 +186,24 @@ public:
     const std::vector<SimTime_t>& getInterThreadLatencies() { return interThreadLatencies; }
     const SimTime_t getInterThreadMinLatency() { return interThreadMinLatency; }
     static TimeConverter* getMinPartTC() { return minPartTC; }
+    /** Return whether the thread barriers sleep after spinning for a while */
+    static bool isHybridBarrier() { return barrier.isHybrid(); }
+    /** Return whether the thread barriers combine arrivals in a tree */
+    static bool isTreeBarrier() { return barrier.isTree(); }
+
+    /** Return whether handlers are being counted for a partition
+     * profile */
+    static bool isProfiling() { return profiling; }
+    /** Count the calls to a clock handler of a component, and the time
+     * they take, when profiling.  For use by SST Core only */
+    void setClockHandlerOwner(Clock::HandlerBase* handler, ComponentId_t id);
+    /** Call a clock handler, counting it.  For use by SST Core only */
+    bool executeProfiled(Clock::HandlerBase* handler, Cycle_t cycle);
+    /** Add the counts of this thread's components and links to profile */
+    void collectProfile(Partition::PartitionProfile& profile) const;
+    /** Keep a component on its thread when balancing the load of the
+     * threads.  For use by SST Core only */
+    void pinComponent(ComponentId_t id);
 
     /** Return the TimeLord associated with this Simulation */
     static TimeLord* getTimeLord(void) { return &timeLord; }
@@ -333,6 +361,28 @@ public:
      *  the Rank
      */
     static SimTime_t getLocalMinimumNextActivityTime();
+
+    typedef enum {
+        CHECKPOINT_OK,          /* State saved */
+        CHECKPOINT_STOP,        /* The simulation stops before the end of the window */
+        CHECKPOINT_UNSUPPORTED  /* Some component can't save its state */
+    } CheckpointResult_t;
+
+    /**
+     * Save the state of this thread for optimistic execution: copies
+     * of the pending Events, the position of every other Activity, and
+     * the state of the clocks, one shots and components.  Used by
+     * ThreadSyncOptimistic at the start of a speculative window.
+     * @param until - end of the window
+     */
+    CheckpointResult_t saveCheckpoint(SimTime_t until);
+    /** Why saveCheckpoint() returned CHECKPOINT_UNSUPPORTED */
+    const std::string& getCheckpointProblem() const { return checkpoint_problem; }
+    /** Roll this thread back to the state saved by saveCheckpoint().
+     * Everything scheduled since is dropped. */
+    void restoreCheckpoint();
+    /** Release the state saved by saveCheckpoint() */
+    void discardCheckpoint();
     
     /**
      * Returns the Simulation's SharedRegionManager
@@ -374,6 +424,10 @@ private:
     static Core::ThreadSafe::Barrier barrier;
     static Core::ThreadSafe::Barrier exit_barrier;
     static std::mutex simulationMutex;
+    /** Count handlers for a partition profile */
+    static bool profiling;
+    /** Moves components between the threads of the rank, or NULL */
+    static ThreadLoadBalancer* loadBalancer;
 
 
 
@@ -400,9 +454,17 @@ private:
     } ShutdownMode_t;
 
     friend class SyncManager;
+    friend class ThreadLoadBalancer;
     
     Mode_t   runMode;
     TimeVortex*      timeVortex;
+    bool             batchDispatch;
+    bool             linkFifo;
+    bool             asyncRankSync;
+    bool             pairwiseThreadSync;
+    bool             nullMessageSync;
+    SimTime_t        optimisticWindow;
+    double           loadBalance;
     TimeConverter*   threadMinPartTC;
     Activity*        current_activity;
     static SyncBase* sync;
@@ -438,6 +500,36 @@ private:
     /** Statistics Timing Engine of the simulation */
     Statistics::StatisticProcessingEngine* statisticsEngine;
 
+    /** Clock handler counts of a component, when profiling */
+    struct clock_profile_t {
+        ComponentId_t owner;
+        uint64_t      calls;
+        double        time;
+    };
+    std::unordered_map<Clock::HandlerBase*, clock_profile_t> clockProfile;
+
+    /** Position of an Activity saved by saveCheckpoint() */
+    struct checkpoint_entry_t {
+        Activity* activity;     /* Actions only; Events are copied */
+        Link*     link;         /* delivery link of an Event */
+        SimTime_t time;
+        uint64_t  order;
+        size_t    offset;       /* packed Event copy in checkpoint_events */
+        size_t    size;         /* 0 for Actions */
+    };
+    SimTime_t        checkpoint_time;
+    int              checkpoint_priority;
+    std::vector<checkpoint_entry_t> checkpoint_entries;
+    std::vector<char> checkpoint_events;
+    /** Something in the model that can't be rolled back, empty if none */
+    std::string      checkpoint_problem;
+    bool             checkpoint_checked;
+    /** Event types already checked to be serializable */
+    std::unordered_set<std::type_index> checkpoint_types;
+
+    /** Look for things that saveCheckpoint() can't save */
+    void checkCheckpointSupport();
+
     static std::unordered_map<std::thread::id, Simulation*> instanceMap;
     static std::vector<Simulation*> instanceVec;
 
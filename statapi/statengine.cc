@@ -72,6 +72,15 @@ bool StatisticProcessingEngine::addEventBasedStatistic(const UnitAlgebra& count,
     return true;
 }
 
+bool StatisticProcessingEngine::hasOutputDuringRun() const
+{
+    if ( !m_PeriodicStatisticMap.empty() ) return true;
+    for (StatArray_t::const_iterator it_v = m_EventStatisticArray.begin(); it_v != m_EventStatisticArray.end(); it_v++) {
+        if ( (*it_v)->getCollectionCountLimit() != 0 ) return true;
+    }
+    return false;
+}
+
 void StatisticProcessingEngine::setStatisticStartTime(const UnitAlgebra& startTime, StatisticBase* stat)
 {
     Simulation*           sim = Simulation::getSimulation();
@@ -61,6 +61,9 @@ private:
 
     void endOfSimulation();
     void startOfSimulation();
+    /** Returns true if any statistic is output before the end of the
+     * simulation (periodic, or event based with a count limit) */
+    bool hasOutputDuringRun() const;
     
     template<typename T>
     void registerStatisticWithEngine(const ComponentId_t& compId, StatisticBase* Stat)
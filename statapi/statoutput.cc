@@ -39,6 +39,10 @@ StatisticOutput::~StatisticOutput()
 // Start / Stop of register
 void StatisticOutput::startRegisterFields(const char* componentName, const char* statisticName)
 {
+    // Components register their statistics from their constructors,
+    // which run on all the threads at once.  Hold the lock until
+    // stopRegisterFields().
+    lock();
     m_currentFieldCompName = componentName;
     m_currentFieldStatName = statisticName;
 }
@@ -47,6 +51,7 @@ void StatisticOutput::stopRegisterFields()
 {
     m_currentFieldCompName = "";
     m_currentFieldStatName = "";
+    unlock();
 }
 
 StatisticFieldInfo* StatisticOutput::addFieldToLists(const char* fieldName, fieldType_t fieldType)
@@ -112,10 +112,12 @@ Cycle_t SubComponent::getNextClockCycle( TimeConverter* freq ) {
 //For now, no OneShot support in SubSubComponent
 #if 0
 TimeConverter* SubComponent::registerOneShot( std::string timeDelay, OneShot::HandlerBase* handler) {
+    Simulation::getSimulation()->pinComponent(parent->getId());
     return Simulation::getSimulation()->registerOneShot(timeDelay, handler);
 }
 
 TimeConverter* SubComponent::registerOneShot( const UnitAlgebra& timeDelay, OneShot::HandlerBase* handler) {
+    Simulation::getSimulation()->pinComponent(parent->getId());
     return Simulation::getSimulation()->registerOneShot(timeDelay, handler);
 }
 #endif
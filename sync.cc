@@ -21,10 +21,6 @@
 #include "sst/core/timeConverter.h"
 #include "sst/core/profile.h"
 
-#include <boost/archive/polymorphic_binary_iarchive.hpp>
-#include <boost/iostreams/stream_buffer.hpp>
-#include <boost/iostreams/stream.hpp>
-
 #ifdef SST_CONFIG_HAVE_MPI
 #include <mpi.h>
 #endif
@@ -285,16 +281,8 @@ SyncD::execute(void)
         }
         
         auto deserialStart = SST::Core::Profile::now();
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
-
-        std::vector<Activity*> activities;
-        ia >> activities;
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-            
-            Event* ev = static_cast<Event*>(activities[j]);
+        SyncQueue::unpackData(buffer, [&](Activity* activity) {
+            Event* ev = static_cast<Event*>(activity);
             link_map_t::iterator link = link_map.find(ev->getLinkId());
             if (link == link_map.end()) {
                 printf("Link not found in map!\n");
@@ -304,7 +292,8 @@ SyncD::execute(void)
                 SimTime_t delay = ev->getDeliveryTime() - current_cycle;
                 link->second->send(delay,ev);
             }
-        }
+        });
+        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
         
         // for ( int j = 0; j < count; j++ ) {
         //     Event* ev;
@@ -421,15 +410,8 @@ SyncD::exchangeLinkInitData(int msg_count)
             buffer = i->second.rbuf;
         }
         
-        boost::iostreams::basic_array_source<char> source(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        boost::iostreams::stream<boost::iostreams::basic_array_source <char> > input_stream(source);
-        boost::archive::polymorphic_binary_iarchive ia(input_stream, boost::archive::no_header | boost::archive::no_tracking );
-        
-        std::vector<Activity*> activities;
-        ia >> activities;
-        for ( unsigned int j = 0; j < activities.size(); j++ ) {
-            
-            Event* ev = static_cast<Event*>(activities[j]);
+        SyncQueue::unpackData(buffer, [&](Activity* activity) {
+            Event* ev = static_cast<Event*>(activity);
             link_map_t::iterator link = link_map.find(ev->getLinkId());
             if (link == link_map.end()) {
                 printf("Link not found in map!\n");
@@ -437,7 +419,7 @@ SyncD::exchangeLinkInitData(int msg_count)
             } else {
                 sendInitData_sync(link->second,ev);
             }
-        }
+        });
         
         
         // for ( int j = 0; j < count; j++ ) {
@@ -19,9 +19,13 @@
 #include "sst/core/threadSyncQueue.h"
 #include "sst/core/timeConverter.h"
 
+#include "sst/core/rankSyncNullMessage.h"
 #include "sst/core/rankSyncSerialSkip.h"
 #include "sst/core/rankSyncParallelSkip.h"
 #include "sst/core/rankSyncParallelSkip.h"
+#include "sst/core/threadLoadBalancer.h"
+#include "sst/core/threadSyncOptimistic.h"
+#include "sst/core/threadSyncPairwiseSkip.h"
 #include "sst/core/threadSyncSimpleSkip.h"
 
 namespace SST {
@@ -66,7 +70,7 @@ public:
     void finalizeLinkConfigurations() {}
 
     /** Register a Link which this Sync Object is responsible for */
-    void registerLink(LinkId_t link_id, Link* link) {}
+    void registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link) {}
     ActivityQueue* getQueueForThread(int tid) { return NULL; }
 };
 
@@ -78,17 +82,44 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::
     barrier(barrier),
     threadSync(NULL),
     next_threadSync(0),
-    min_part(min_part)
+    min_part(min_part),
+    async_rank_sync(false),
+    null_message_sync(false),
+    rankSyncCount(0),
+    rankSyncBarriers(0)
 {
     // TraceFunction trace(CALL_INFO_LONG);    
     
     sim = Simulation::getSimulation();
+
+    if ( sim->nullMessageSync && min_part != MAX_SIMTIME_T ) {
+        if ( num_ranks.thread == 1 ) {
+            null_message_sync = true;
+        }
+        else if ( rank.rank == 0 && rank.thread == 0 ) {
+            sim->getSimulationOutput().output("WARNING: --null-message-sync needs one thread per rank.  Using the default rank sync.\n");
+        }
+    }
+
+    // Asynchronous rank syncs run windows of half the lookahead, so
+    // they need a lookahead of at least two core cycles.
+    if ( sim->asyncRankSync && !null_message_sync && min_part != MAX_SIMTIME_T ) {
+        if ( num_ranks.thread == 1 && min_part >= 2 ) {
+            async_rank_sync = true;
+        }
+        else if ( rank.rank == 0 && rank.thread == 0 ) {
+            sim->getSimulationOutput().output("WARNING: --async-rank-sync needs one thread per rank and a partition lookahead of at least 2 core cycles.  Using the blocking rank sync.\n");
+        }
+    }
     
     if ( rank.thread == 0  ) {
         // if ( num_ranks.rank > 1 ) {
         if ( min_part != MAX_SIMTIME_T ) {
-            if ( num_ranks.thread == 1 ) {
-                rankSync = new RankSyncSerialSkip(/*num_ranks,*/ barrier, minPartTC);
+            if ( null_message_sync ) {
+                rankSync = new RankSyncNullMessage(minPartTC);
+            }
+            else if ( num_ranks.thread == 1 ) {
+                rankSync = new RankSyncSerialSkip(/*num_ranks,*/ barrier, minPartTC, async_rank_sync);
             }
             else {
                 rankSync = new RankSyncParallelSkip(num_ranks, barrier, minPartTC);
@@ -105,7 +136,42 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::
     // of the active threadsyncs.
     SimTime_t interthread_minlat = sim->getInterThreadMinLatency();
     if ( num_ranks.thread > 1 && interthread_minlat != MAX_SIMTIME_T ) {
-        threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        // Speculative windows only pay off if they are longer than
+        // the lookahead.  Events held back by link FIFOs aren't in
+        // the TimeVortex, so they can't be saved.
+        bool optimistic = sim->optimisticWindow > interthread_minlat && num_ranks.rank == 1 && !sim->linkFifo;
+        if ( sim->optimisticWindow != 0 && !optimistic && rank.rank == 0 && rank.thread == 0 ) {
+            sim->getSimulationOutput().output("WARNING: --optimistic-window needs a single rank, no --link-fifo and a window longer than the inter-thread lookahead.  Using a conservative thread sync.\n");
+        }
+
+        if ( optimistic ) {
+            if ( rank.thread == 0 ) {
+                sim->getSimulationOutput().output("WARNING: --optimistic-window is experimental.  Output written during a rolled back window is not undone; see --help for the other limits.\n");
+            }
+            threadSync = new ThreadSyncOptimistic(num_ranks.thread, rank.thread, Simulation::getSimulation(), sim->optimisticWindow);
+        }
+        else if ( sim->pairwiseThreadSync && num_ranks.rank == 1 ) {
+            threadSync = new ThreadSyncPairwiseSkip(num_ranks.thread, rank.thread, Simulation::getSimulation(), interThreadLatencies);
+        }
+        else {
+            if ( sim->pairwiseThreadSync && rank.rank == 0 && rank.thread == 0 ) {
+                sim->getSimulationOutput().output("WARNING: --pairwise-thread-sync is only supported for single rank simulations.  Using the default thread sync.\n");
+            }
+            threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        }
+
+        // Components can only be moved while every pair of threads
+        // syncs at the smallest lookahead.  Events held back by link
+        // FIFOs aren't in the TimeVortex, so they can't be moved with
+        // their component.
+        if ( sim->loadBalance > 0.0 && rank.thread == 0 ) {
+            if ( dynamic_cast<ThreadSyncSimpleSkip*>(threadSync) != NULL && !sim->linkFifo ) {
+                Simulation::loadBalancer = new ThreadLoadBalancer(num_ranks.thread, sim->loadBalance, barrier);
+            }
+            else if ( rank.rank == 0 ) {
+                sim->getSimulationOutput().output("WARNING: --load-balance needs the default thread sync and no --link-fifo.  Components stay on their threads.\n");
+            }
+        }
     }
     else {
         threadSync = new EmptyThreadSync();
@@ -117,13 +183,30 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, Core::
 }
 
 
-SyncManager::~SyncManager() {}
+SyncManager::~SyncManager()
+{
+    if ( rankSyncCount > 0 && rank.thread == 0 ) {
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "SyncManager %" PRIu64 " rank syncs, %" PRIu64 " barrier waits.\n", rankSyncCount, rankSyncBarriers);
+    }
+    if ( rank.thread == 0 ) {
+        delete rankSync;
+        rankSync = NULL;
+        delete Simulation::loadBalancer;
+        Simulation::loadBalancer = NULL;
+    }
+    delete threadSync;
+}
 
 /** Register a Link which this Sync Object is responsible for */
 ActivityQueue*
 SyncManager::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
 {
     // TraceFunction trace(CALL_INFO_LONG);    
+    // The syncs don't look links up by id.  Events sent on a link
+    // carry the position of the link among the links between the two
+    // threads (or ranks), which the sync on the other side indexes
+    // directly.  Each thread registers its links in link id order, so
+    // that position is the same at both ends.
     if ( to_rank == from_rank ) {
         // trace.getOutput().output(CALL_INFO, "The impossible happened\n");
         return NULL;  // This should never happen
@@ -136,7 +219,7 @@ SyncManager::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, Li
         // side of the link
 
         // For the local ThreadSync, just need to register the link
-        threadSync->registerLink(link_id, link);
+        threadSync->registerLink(to_rank, from_rank, link_id, link);
 
         // Need to get target queue from the remote ThreadSync
         NewThreadSync* remoteSync = Simulation::instanceVec[to_rank.thread]->syncManager->threadSync;
@@ -144,7 +227,9 @@ SyncManager::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, Li
         return remoteSync->getQueueForThread(from_rank.thread);
     }
     else {
-        // Different rank.  Send info onto the RankSync
+        // Different rank.  Send info onto the RankSync, which is
+        // shared by all the threads wiring up
+        std::lock_guard<std::mutex> lock(sync_mutex);
         return rankSync->registerLink(to_rank, from_rank, link_id, link);
     }
 }
@@ -156,6 +241,16 @@ SyncManager::execute(void)
     // trace.getOutput().output(CALL_INFO, "next_sync_type @ switch = %d\n", next_sync_type);
     switch ( next_sync_type ) {
     case RANK:
+    {
+        rankSyncCount++;
+        uint64_t waits = Core::ThreadSafe::Barrier::getWaitCount();
+
+        if ( rankSync->checksExit() ) {
+            executeFusedRankSync();
+            rankSyncBarriers += Core::ThreadSafe::Barrier::getWaitCount() - waits;
+            break;
+        }
+
         // Need to make sure all threads have reached the sync to
         // guarantee that all events have been sent to the appropriate
         // queues.
@@ -185,7 +280,11 @@ SyncManager::execute(void)
 
         barrier.wait();
         
-        if ( exit != NULL && rank.thread == 0 ) exit->check();
+        // The null message sync does its own exit checks
+        if ( exit != NULL && rank.thread == 0 && !null_message_sync ) {
+            if ( async_rank_sync ) exit->checkAsync();
+            else exit->check();
+        }
 
         barrier.wait();
 
@@ -193,13 +292,19 @@ SyncManager::execute(void)
             endSimulation(exit->getEndTime());
         }
 
+        rankSyncBarriers += Core::ThreadSafe::Barrier::getWaitCount() - waits;
         break;
+    }
     case THREAD:
 
         threadSync->execute();
+
+        if ( Simulation::loadBalancer != NULL ) Simulation::loadBalancer->execute(rank.thread);
         
         if ( /*num_ranks.rank == 1*/ min_part == MAX_SIMTIME_T ) {
             if ( exit->getRefCount() == 0 ) {
+                // Don't hold up threads that have not seen the exit yet
+                threadSync->finish();
                 endSimulation(exit->getEndTime());
             }
         }
@@ -213,6 +318,30 @@ SyncManager::execute(void)
     // trace.getOutput().output(CALL_INFO, "next_sync_type = %d\n", next_sync_type);
 }
 
+void
+SyncManager::executeFusedRankSync()
+{
+    // All events sent to other threads and ranks are in the queues
+    barrier.wait();
+
+    threadSync->before();
+
+    // With more than one thread, the rank sync looks at every
+    // thread's TimeVortex, so all of them need to be up to date
+    if ( num_ranks.thread > 1 ) barrier.wait();
+
+    // Exchanges the events, then does one reduction for the next sync
+    // time and the exit check.  The results are seen by every thread
+    // when this returns.
+    rankSync->execute(rank.thread);
+
+    threadSync->after();
+
+    if ( exit->getGlobalCount() == 0 ) {
+        endSimulation(exit->getEndTime());
+    }
+}
+
 /** Cause an exchange of Initialization Data to occur */
 void
 SyncManager::exchangeLinkInitData(std::atomic<int>& msg_count)
@@ -239,6 +368,16 @@ SyncManager::finalizeLinkConfigurations()
     computeNextInsert();
 }
 
+void
+SyncManager::finish()
+{
+    threadSync->finish();
+    if ( rank.thread == 0 && sim->shutdown_mode == Simulation::SHUTDOWN_CLEAN ) {
+        rankSync->finish();
+        if ( async_rank_sync ) exit->finishCheck();
+    }
+}
+
 void
 SyncManager::computeNextInsert()
 {
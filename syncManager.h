@@ -41,6 +41,11 @@ public:
     virtual void execute(int thread) = 0;
     virtual void exchangeLinkInitData(int thread, std::atomic<int>& msg_count) = 0;
     virtual void finalizeLinkConfigurations() = 0;
+    /** Complete any communication still in flight at the end of the run */
+    virtual void finish() {}
+    /** Returns true if execute() also does the exit check, in the same
+     * reduction as the next sync time */
+    virtual bool checksExit() { return false; }
 
     virtual SimTime_t getNextSyncTime() { return nextSyncTime; }
 
@@ -61,6 +66,20 @@ protected:
         link->sendInitData_sync(init_data);
     }
 
+    /** Returns the latency of the local end of a link passed to
+     * registerLink(), i.e. the minimum delay of anything sent to the
+     * remote rank on it */
+    SimTime_t getSendLatency(Link* link) {
+        return link->pair_link->latency;
+    }
+
+    /** Sets the index carried by events sent to the remote rank on a
+     * link passed to registerLink().  The sync on the remote rank uses
+     * it to find its end of the link without a map lookup. */
+    void setSyncIndex(Link* link, LinkId_t index) {
+        link->pair_link->sync_index = index;
+    }
+
 private:
     
 };
@@ -75,6 +94,8 @@ public:
     virtual void execute() = 0;
     virtual void processLinkInitData() = 0;
     virtual void finalizeLinkConfigurations() = 0;
+    /** Called when this thread stops running events */
+    virtual void finish() {}
 
     virtual SimTime_t getNextSyncTime() { return nextSyncTime; }
 
@@ -82,7 +103,11 @@ public:
     TimeConverter* getMaxPeriod() {return max_period;}
 
     /** Register a Link which this Sync Object is responsible for */
-    virtual void registerLink(LinkId_t link_id, Link* link) = 0;
+    virtual void registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link) = 0;
+    /** Remove a Link registered at the given sync index during the
+     * run.  The index may be reused by a later registerLink().  Only
+     * needed by the syncs the ThreadLoadBalancer is used with. */
+    virtual void unregisterLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t index) {}
     virtual ActivityQueue* getQueueForThread(int tid) = 0;
     
 protected:
@@ -97,6 +122,13 @@ protected:
         link->sendInitData_sync(init_data);
     }
 
+    /** Sets the index carried by events sent to the other thread on a
+     * link passed to registerLink().  The sync on the other thread uses
+     * it to find its end of the link without a map lookup. */
+    void setSyncIndex(Link* link, LinkId_t index) {
+        link->pair_link->sync_index = index;
+    }
+
 private:
 };
 
@@ -107,12 +139,20 @@ public:
 
     /** Register a Link which this Sync Object is responsible for */
     ActivityQueue* registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link);
+    /** Remove a Link to another thread registered at the given sync
+     * index.  Used when components move between threads. */
+    void unregisterLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t index) {
+        threadSync->unregisterLink(to_rank, from_rank, index);
+    }
     void execute(void);
 
     /** Cause an exchange of Initialization Data to occur */
     void exchangeLinkInitData(std::atomic<int>& msg_count);
     /** Finish link configuration */
     void finalizeLinkConfigurations();
+    /** Called by each thread when it stops running events.  Completes
+     * any communication still in flight. */
+    void finish();
 
     void print(const std::string& header, Output &out) const;
 
@@ -135,8 +175,15 @@ private:
     
     sync_type_t      next_sync_type;
     SimTime_t min_part;
+    bool      async_rank_sync;
+    bool      null_message_sync;
+
+    uint64_t  rankSyncCount;
+    uint64_t  rankSyncBarriers;
     
     void computeNextInsert();
+    /** Rank sync for rank syncs that do the exit check themselves */
+    void executeFusedRankSync();
     
 };
 
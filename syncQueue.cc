@@ -17,41 +17,122 @@
 #include <sst/core/event.h>
 
 #include <sst/core/simulation.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <cstring>
 
 
 namespace SST {
 
-using namespace Core::ThreadSafe;
 using namespace Core::Serialization;
 
-SyncQueue::SyncQueue() :
-    ActivityQueue(), buffer(NULL), buf_size(0)
+// Initial size of the send buffer
+static const size_t INITIAL_BUFFER_SIZE = 4096;
+
+SyncQueue::Lane::Lane(size_t offset, bool timed) :
+    ActivityQueue(),
+    buffer(new char[INITIAL_BUFFER_SIZE]),
+    buf_size(INITIAL_BUFFER_SIZE),
+    offset(offset),
+    data_size(offset),
+    count(0),
+    timed(timed),
+    serializeTime(0.0)
+{
+}
+
+SyncQueue::Lane::~Lane()
+{
+    delete[] buffer;
+}
+
+void
+SyncQueue::Lane::insert(Activity* activity)
 {
+    // Pack straight into the free space at the end of the buffer.
+    // The packer checks its bounds, so if the Activity does not fit,
+    // grow the buffer and pack it again.  This avoids a separate
+    // sizing pass over every Activity.
+    std::chrono::steady_clock::time_point packStart;
+    if ( timed ) packStart = now();
+    while ( true ) {
+        ser.start_packing(buffer + data_size, buf_size - data_size);
+        try {
+            ser & activity;
+            break;
+        }
+        catch ( pvt::ser_buffer_overrun& e ) {
+            grow(2 * buf_size);
+        }
+    }
+    data_size += ser.size();
+    count++;
+
+    delete activity;
+    if ( timed ) serializeTime += getElapsed(packStart);
+}
+
+void
+SyncQueue::Lane::grow(size_t min_size)
+{
+    size_t new_size = buf_size;
+    while ( new_size < min_size ) new_size *= 2;
+    char* new_buffer = new char[new_size];
+    memcpy(new_buffer, buffer, data_size);
+    delete[] buffer;
+    buffer = new_buffer;
+    buf_size = new_size;
+}
+
+
+SyncQueue::SyncQueue(uint32_t num_lanes) :
+    ActivityQueue(),
+    main(sizeof(SyncQueue::Header), Output::getDefaultObject().getVerboseLevel() > 0),
+    spare_buffer(NULL),
+    spare_size(0),
+    mergeTime(0.0)
+{
+    for ( uint32_t i = 1; i < num_lanes; i++ ) {
+        lanes.push_back(new Lane(0, main.timed));
+    }
 }
 
 SyncQueue::~SyncQueue()
 {
+    for ( size_t i = 0; i < lanes.size(); i++ ) {
+        delete lanes[i];
+    }
+    delete[] spare_buffer;
 }
     
 bool
 SyncQueue::empty()
 {
-    std::lock_guard<Spinlock> lock(slock);
-	return activities.empty();
+    return size() == 0;
 }
 
 int
 SyncQueue::size()
 {
-    std::lock_guard<Spinlock> lock(slock);
-    return activities.size();
+    int total = main.count;
+    for ( size_t i = 0; i < lanes.size(); i++ ) {
+        total += lanes[i]->count;
+    }
+    return total;
 }
     
 void
 SyncQueue::insert(Activity* activity)
 {
-    std::lock_guard<Spinlock> lock(slock);
-    activities.push_back(activity);
+    main.insert(activity);
+}
+
+ActivityQueue*
+SyncQueue::getLane(uint32_t thread)
+{
+    if ( thread == 0 ) return &main;
+    return lanes[thread - 1];
 }
 
 Activity*
@@ -76,46 +157,71 @@ SyncQueue::front()
 void
 SyncQueue::clear()
 {
-    std::lock_guard<Spinlock> lock(slock);
-    activities.clear();
+    main.reset();
+    for ( size_t i = 0; i < lanes.size(); i++ ) {
+        lanes[i]->reset();
+    }
 }
 
-char*
-SyncQueue::getData()
+void
+SyncQueue::swapBuffers()
 {
-    std::lock_guard<Spinlock> lock(slock);
-
-    serializer ser;
-
-    ser.start_sizing();
+    if ( spare_buffer == NULL ) {
+        spare_buffer = new char[INITIAL_BUFFER_SIZE];
+        spare_size = INITIAL_BUFFER_SIZE;
+    }
+    std::swap(main.buffer, spare_buffer);
+    std::swap(main.buf_size, spare_size);
+    clear();
+}
 
-    ser & activities;
+uint64_t
+SyncQueue::getDataSize()
+{
+    uint64_t total = main.buf_size + spare_size;
+    for ( size_t i = 0; i < lanes.size(); i++ ) {
+        total += lanes[i]->buf_size;
+    }
+    return total;
+}
 
-    size_t size = ser.size();
+double
+SyncQueue::getSerializeTime() const
+{
+    double total = main.serializeTime + mergeTime;
+    for ( size_t i = 0; i < lanes.size(); i++ ) {
+        total += lanes[i]->serializeTime;
+    }
+    return total;
+}
 
-    if ( buf_size < ( size + sizeof(SyncQueue::Header) ) ) {
-        if ( buffer != NULL ) {
-            delete[] buffer;
+char*
+SyncQueue::getData()
+{
+    // Move what the other lanes have packed to the end of the send
+    // buffer
+    if ( !lanes.empty() ) {
+        auto mergeStart = now();
+        for ( size_t i = 0; i < lanes.size(); i++ ) {
+            Lane* lane = lanes[i];
+            if ( lane->count == 0 ) continue;
+            if ( main.data_size + lane->data_size > main.buf_size ) {
+                main.grow(main.data_size + lane->data_size);
+            }
+            memcpy(main.buffer + main.data_size, lane->buffer, lane->data_size);
+            main.data_size += lane->data_size;
+            main.count += lane->count;
+            lane->reset();
         }
-        
-        buf_size = size + sizeof(SyncQueue::Header);
-        buffer = new char[buf_size];
+        mergeTime += getElapsed(mergeStart);
     }
-        
-    ser.start_packing(buffer + sizeof(SyncQueue::Header), size);
 
-    ser & activities;
+    // Set the count and size fields in the header
+    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(main.buffer);
+    hdr->count = main.count;
+    hdr->buffer_size = main.data_size;
 
-    // Delete all the events
-    for ( unsigned int i = 0; i < activities.size(); i++ ) {
-        delete activities[i];
-    }
-    activities.clear();
-
-    // Set the size field in the header
-    static_cast<SyncQueue::Header*>(static_cast<void*>(buffer))->buffer_size = size + sizeof(SyncQueue::Header);
-    
-    return buffer;
+    return main.buffer;
 }
 
 } // namespace SST
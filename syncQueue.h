@@ -14,10 +14,12 @@
 
 //#include <sst/core/serialization.h>
 
-#include <vector>
-
 #include <sst/core/activityQueue.h>
 #include <sst/core/threadsafe.h>
+#include <sst/core/serialization/serializer.h>
+
+#include <chrono>
+#include <vector>
 
 namespace SST {
 
@@ -27,6 +29,21 @@ namespace SST {
  * Internal API
  *
  * Activity Queue for use by Sync Objects
+ *
+ * The wire format produced by getData() is a Header followed by
+ * Header::count Activities, each packed on its own with the native
+ * serializer.  unpackData() reads them back directly out of the
+ * receive buffer.
+ *
+ * Activities are packed into the send buffer as they are inserted, by
+ * the thread that sends them, and then deleted.  The buffer only
+ * grows and is reused from one sync to the next.
+ *
+ * Each sending thread inserts into its own lane (see getLane()), so
+ * inserts never take a lock.  Lane 0 is the send buffer itself; the
+ * other lanes pack into buffers of their own, which getData() appends
+ * to the send buffer.  Since every Activity is packed on its own, the
+ * result is the same as if they had all been packed there.
  */
 class SyncQueue : public ActivityQueue {
 public:
@@ -35,33 +52,114 @@ public:
         uint32_t mode;
         uint32_t count;
         uint32_t buffer_size;
+        uint64_t time;      /* only used by syncs that send a time bound with the data */
     };
     
-    SyncQueue();
+    /** @param num_lanes - number of threads that insert into the queue */
+    SyncQueue(uint32_t num_lanes = 1);
     ~SyncQueue();
 
     bool empty();
     int size();
+    /** Insert into lane 0 */
     void insert(Activity* activity);
     Activity* pop(); // Not a good idea for this particular class
     Activity* front();
 
     // Not part of the ActivityQueue interface
-    /** Clear elements from the queue */
+    /** Returns the queue for Activities sent by a thread.  Only that
+     * thread may insert into it. */
+    ActivityQueue* getLane(uint32_t thread);
+    /** Clear elements from the queue.  Must not be called until the
+     * buffer returned by getData() is no longer in use. */
     void clear();
-    /** Accessor method to the internal queue */
+    /** Returns the send buffer, starting with the Header.  Must not
+     * be called while any thread is inserting. */
     char* getData();
+    /** Switch to a second send buffer and clear it, leaving the buffer
+     * returned by getData() untouched.  Used by asynchronous syncs to
+     * keep one buffer in flight while the next is filled.  The two
+     * buffers alternate on each call. */
+    void swapBuffers();
+
+    uint64_t getDataSize();
+
+    /** Total time spent packing Activities into the send buffers
+     * and in getData().  Packing is only timed when the core output is
+     * verbose, since that is the only time it is reported and it costs
+     * two clock reads per Activity. */
+    double getSerializeTime() const;
 
-    uint64_t getDataSize() {
-        return buf_size + (activities.capacity() * sizeof(Activity*));
+    /** Time stamps for the serialize and deserialize times reported
+     * by the rank syncs.  Unlike Core::Profile, these are not compiled
+     * out. */
+    static std::chrono::steady_clock::time_point now() {
+        return std::chrono::steady_clock::now();
+    }
+    static double getElapsed(const std::chrono::steady_clock::time_point& since) {
+        return std::chrono::duration<double>(now() - since).count();
+    }
+
+    /** Deserialize the Activities in a buffer created by getData().
+     * Each Activity is unpacked straight from the buffer and passed to
+     * deliver, so no intermediate container is needed.
+     * @param buffer - received buffer, starting with the Header
+     * @param deliver - called as deliver(Activity*) for each Activity
+     */
+    template <typename DELIVER>
+    static void unpackData(char* buffer, DELIVER deliver) {
+        Header* hdr = reinterpret_cast<Header*>(buffer);
+        uint32_t count = hdr->count;
+
+        Core::Serialization::serializer ser;
+        ser.start_unpacking(buffer + sizeof(Header), hdr->buffer_size - sizeof(Header));
+        for ( uint32_t i = 0; i < count; i++ ) {
+            Activity* activity = NULL;
+            ser & activity;
+            deliver(activity);
+        }
     }
     
 private:
-    char* buffer;
-    int buf_size;
-    std::vector<Activity*> activities;
+    /** Packed Activities from one sending thread */
+    class Lane : public ActivityQueue {
+    public:
+        /** @param offset - bytes to leave free at the start of the buffer
+         *  @param timed - whether to time the packing */
+        Lane(size_t offset, bool timed);
+        ~Lane();
+
+        bool empty() { return count == 0; }
+        int size() { return count; }
+        void insert(Activity* activity);
+        /** Not supported */
+        Activity* pop() { return NULL; }
+        /** Not supported */
+        Activity* front() { return NULL; }
+
+        /** Make room for at least min_size bytes, keeping the contents */
+        void grow(size_t min_size);
+        /** Drop the packed Activities */
+        void reset() {
+            data_size = offset;
+            count = 0;
+        }
+
+        char* buffer;
+        size_t buf_size;
+        size_t offset;
+        size_t data_size;   /* bytes packed so far, including the offset */
+        uint32_t count;
+        bool timed;
+        double serializeTime;
+        Core::Serialization::serializer ser;
+    };
 
-    Core::ThreadSafe::Spinlock slock;
+    Lane main;          /* lane 0, which is also the send buffer */
+    std::vector<Lane*> lanes;   /* lanes 1 and up */
+    char* spare_buffer;
+    size_t spare_size;
+    double mergeTime;
 };
 
  
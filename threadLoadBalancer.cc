@@ -0,0 +1,382 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/threadLoadBalancer.h"
+
+#include <algorithm>
+
+#include "sst/core/component.h"
+#include "sst/core/componentInfo.h"
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/linkMap.h"
+#include "sst/core/output.h"
+#include "sst/core/simulation.h"
+#include "sst/core/syncManager.h"
+#include "sst/core/timeConverter.h"
+#include "sst/core/timeVortex.h"
+
+namespace SST {
+
+// Thread syncs between looks at the handler times
+static const uint64_t CHECK_INTERVAL = 64;
+// Seconds of handler time the busiest thread needs before the times
+// are trusted
+static const double MIN_WINDOW = 0.05;
+
+ThreadLoadBalancer::ThreadLoadBalancer(int num_threads, double threshold, Core::ThreadSafe::Barrier& barrier) :
+    num_threads(num_threads),
+    threshold(threshold),
+    barrier(barrier),
+    threads(num_threads),
+    window_done(false),
+    moves(0)
+{
+}
+
+ThreadLoadBalancer::~ThreadLoadBalancer()
+{
+    if ( moves > 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadLoadBalancer moved %" PRIu64 " components between threads.\n", moves);
+}
+
+void
+ThreadLoadBalancer::addComponent(ComponentId_t id, int thread)
+{
+    std::lock_guard<std::mutex> lock(wireup_mutex);
+    components[id].thread = thread;
+}
+
+void
+ThreadLoadBalancer::addLink(LinkId_t id, int side, ComponentId_t comp, int thread, Link* end, Link* stub)
+{
+    std::lock_guard<std::mutex> lock(wireup_mutex);
+    link_t& link = links[id];
+    link.comp[side] = comp;
+    link.thread[side] = thread;
+    link.end[side] = end;
+    link.stub[side] = stub;
+    // Links between threads get the same sync index on both sides at
+    // wire-up, so the index of the stub is its end's
+    if ( stub != NULL ) link.index[side] = end->sync_index;
+    components[comp].links.push_back(id);
+}
+
+void
+ThreadLoadBalancer::pin(ComponentId_t id)
+{
+    std::lock_guard<std::mutex> lock(pin_mutex);
+    pinned.insert(id);
+}
+
+void
+ThreadLoadBalancer::execute(int thread)
+{
+    thread_t& me = threads[thread];
+    if ( ++me.syncs % CHECK_INTERVAL != 0 ) return;
+
+    measure(thread);
+    barrier.wait();
+
+    // Everything else is parked at the barrier, so thread 0 can work
+    // on the Simulations of all the threads
+    if ( thread == 0 ) balance();
+    barrier.wait();
+
+    if ( window_done ) {
+        for ( size_t i = 0; i < me.costs.size(); i++ ) {
+            components.find(me.costs[i].id)->second.start = me.costs[i].total;
+        }
+    }
+    addClockHandlers(thread);
+}
+
+void
+ThreadLoadBalancer::measure(int thread)
+{
+    thread_t& me = threads[thread];
+    Simulation* sim = Simulation::instanceVec[thread];
+
+    std::unordered_map<ComponentId_t, double> clock_time;
+    for ( auto it = sim->clockProfile.begin(); it != sim->clockProfile.end(); ++it ) {
+        clock_time[it->second.owner] += it->second.time;
+    }
+
+    me.costs.clear();
+    me.busy = 0.0;
+    for ( ComponentInfoMap::const_iterator it = sim->compInfoMap.begin(); it != sim->compInfoMap.end(); ++it ) {
+        // Only looked up, the map is shared by all the threads
+        auto comp = components.find((*it)->getID());
+        if ( comp == components.end() ) continue;
+
+        cost_t cost;
+        cost.id = (*it)->getID();
+        auto clock = clock_time.find(cost.id);
+        cost.total = clock == clock_time.end() ? 0.0 : clock->second;
+        if ( (*it)->getLinkMap() != NULL ) {
+            std::map<std::string, Link*>& link_map = (*it)->getLinkMap()->getLinkMap();
+            for ( std::map<std::string, Link*>::iterator link = link_map.begin(); link != link_map.end(); ++link ) {
+                cost.total += link->second->getProfileTime();
+            }
+        }
+        cost.window = cost.total - comp->second.start;
+        me.busy += cost.window;
+        me.costs.push_back(cost);
+    }
+}
+
+void
+ThreadLoadBalancer::balance()
+{
+    window_done = false;
+
+    int busiest = 0;
+    int idlest = 0;
+    double total = 0.0;
+    for ( int i = 0; i < num_threads; i++ ) {
+        total += threads[i].busy;
+        if ( threads[i].busy > threads[busiest].busy ) busiest = i;
+        if ( threads[i].busy < threads[idlest].busy ) idlest = i;
+    }
+
+    // Keep adding to the window until the times mean something
+    if ( threads[busiest].busy < MIN_WINDOW ) return;
+    window_done = true;
+
+    if ( threads[busiest].busy <= threshold * total / num_threads ) return;
+
+    // Move the most expensive components that fit in half the
+    // difference
+    double target = (threads[busiest].busy - threads[idlest].busy) / 2;
+    std::vector<cost_t> candidates = threads[busiest].costs;
+    std::sort(candidates.begin(), candidates.end());
+
+    double moved = 0.0;
+    size_t count = 0;
+    std::unordered_set<Link*> moved_links;
+    for ( size_t i = 0; i < candidates.size(); i++ ) {
+        if ( candidates[i].window <= 0.0 ) break;
+        if ( moved + candidates[i].window > target ) continue;
+        if ( !canMove(candidates[i].id, idlest) ) continue;
+        move(candidates[i].id, busiest, idlest, moved_links);
+        moved += candidates[i].window;
+        count++;
+    }
+    if ( count == 0 ) return;
+
+    moveEvents(busiest, idlest, moved_links);
+    moves += count;
+
+    Simulation* sim = Simulation::instanceVec[0];
+    sim->getSimulationOutput().verbose(CALL_INFO, 1, 0,
+        "Moved %zu components (%lg of %lg seconds) from thread %d to thread %d at %" PRIu64 "\n",
+        count, moved, threads[busiest].busy, busiest, idlest, sim->getCurrentSimCycle());
+}
+
+bool
+ThreadLoadBalancer::canMove(ComponentId_t id, int to)
+{
+    if ( pinned.count(id) ) return false;
+
+    SimTime_t lookahead = Simulation::instanceVec[0]->getInterThreadMinLatency();
+    component_t& comp = components.find(id)->second;
+    for ( size_t i = 0; i < comp.links.size(); i++ ) {
+        link_t& link = links.find(comp.links[i])->second;
+        // Links to other ranks are registered with the rank sync
+        if ( link.thread[0] < 0 || link.thread[1] < 0 ) return false;
+
+        for ( int side = 0; side < 2; side++ ) {
+            if ( link.comp[side] != id ) continue;
+            int other = 1 - side;
+            int other_thread = link.comp[other] == id ? to : link.thread[other];
+            if ( other_thread == to ) continue;
+
+            // The link will be between threads, so neither direction
+            // may be shorter than the sync period
+            SimTime_t out = link.end[side]->latency + (link.stub[other] ? link.stub[other]->latency : 0);
+            SimTime_t in = link.end[other]->latency + (link.stub[side] ? link.stub[side]->latency : 0);
+            if ( out < lookahead || in < lookahead ) return false;
+        }
+    }
+    return true;
+}
+
+void
+ThreadLoadBalancer::move(ComponentId_t id, int from, int to, std::unordered_set<Link*>& moved_links)
+{
+    Simulation* src = Simulation::instanceVec[from];
+    Simulation* dst = Simulation::instanceVec[to];
+
+    component_t& comp = components.find(id)->second;
+    comp.thread = to;
+    for ( size_t i = 0; i < comp.links.size(); i++ ) {
+        link_t& link = links.find(comp.links[i])->second;
+        int old_thread[2] = { link.thread[0], link.thread[1] };
+        for ( int side = 0; side < 2; side++ ) {
+            if ( link.comp[side] == id ) link.thread[side] = to;
+        }
+        relink(comp.links[i], old_thread);
+    }
+
+    ComponentInfo* info = src->compInfoMap.getByID(id);
+    src->compInfoMap.erase(info);
+    dst->compInfoMap.insert(info);
+    info->getComponent()->sim = dst;
+
+    // Events for the component are delivered on the links in its
+    // LinkMap, self links included
+    std::map<std::string, Link*>& link_map = info->getLinkMap()->getLinkMap();
+    for ( std::map<std::string, Link*>::iterator it = link_map.begin(); it != link_map.end(); ++it ) {
+        Link* link = it->second;
+        if ( link->recvQueue == src->timeVortex ) link->recvQueue = dst->timeVortex;
+        moved_links.insert(link);
+    }
+
+    moveClocks(id, from, to);
+}
+
+void
+ThreadLoadBalancer::relink(LinkId_t id, const int old_thread[2])
+{
+    link_t& link = links.find(id)->second;
+    Simulation* sim = Simulation::instanceVec[0];
+
+    // Recv latency added to a side goes on the stub that delivers to
+    // it, or on the other side's latency if there is no stub.  The
+    // old stubs are taken out of the tables of the thread syncs, which
+    // reuse their indices for the new ones.  Nothing is in flight on
+    // them between syncs.
+    SimTime_t extra[2] = { 0, 0 };
+    for ( int i = 0; i < 2; i++ ) {
+        if ( link.stub[i] == NULL ) continue;
+        extra[i] = link.stub[i]->latency;
+        RankInfo local(sim->getRank().rank, old_thread[i]);
+        RankInfo remote(sim->getRank().rank, old_thread[1 - i]);
+        Simulation::instanceVec[local.thread]->syncManager->unregisterLink(remote, local, link.index[i]);
+        delete link.stub[i];
+        link.stub[i] = NULL;
+    }
+
+    if ( link.thread[0] == link.thread[1] ) {
+        for ( int i = 0; i < 2; i++ ) {
+            link.end[i]->latency += extra[1 - i];
+            link.end[i]->pair_link = link.end[1 - i];
+            link.end[i]->sync_index = -1;
+        }
+        return;
+    }
+
+    // Same as the wire-up of a link between threads
+    for ( int i = 0; i < 2; i++ ) {
+        Link* stub = new Link(id);
+        stub->setLatency(extra[i]);
+        stub->setDefaultTimeBase(sim->minPartToTC(1));
+        stub->pair_link = link.end[i];
+        link.end[i]->pair_link = stub;
+        link.stub[i] = stub;
+    }
+    for ( int i = 0; i < 2; i++ ) {
+        RankInfo local(sim->getRank().rank, link.thread[i]);
+        RankInfo remote(sim->getRank().rank, link.thread[1 - i]);
+        Link* stub = link.stub[i];
+        stub->recvQueue = Simulation::instanceVec[local.thread]->syncManager->registerLink(remote, local, id, stub);
+        stub->configuredQueue = NULL;
+        stub->initQueue = Link::afterInitQueue;
+    }
+
+    // Registering a stub gives its end the stub's index in the table
+    // of its own thread.  Events sent from an end are looked up by the
+    // sync of the other thread, so each end needs the other's index.
+    for ( int i = 0; i < 2; i++ ) {
+        link.index[i] = link.end[i]->sync_index;
+    }
+    link.end[0]->sync_index = link.index[1];
+    link.end[1]->sync_index = link.index[0];
+}
+
+void
+ThreadLoadBalancer::moveEvents(int from, int to, const std::unordered_set<Link*>& moved_links)
+{
+    TimeVortex* src = Simulation::instanceVec[from]->timeVortex;
+    TimeVortex* dst = Simulation::instanceVec[to]->timeVortex;
+
+    std::vector<Activity*> events;
+    src->extractEvents(moved_links, events);
+    for ( size_t i = 0; i < events.size(); i++ ) {
+        dst->insert(events[i]);
+    }
+}
+
+void
+ThreadLoadBalancer::moveClocks(ComponentId_t id, int from, int to)
+{
+    Simulation* src = Simulation::instanceVec[from];
+    Simulation* dst = Simulation::instanceVec[to];
+
+    std::unordered_set<Clock::HandlerBase*> handlers;
+    for ( auto it = src->clockProfile.begin(); it != src->clockProfile.end(); ) {
+        if ( it->second.owner == id ) {
+            handlers.insert(it->first);
+            dst->clockProfile[it->first] = it->second;
+            it = src->clockProfile.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    for ( Simulation::clockMap_t::iterator it = src->clockMap.begin(); it != src->clockMap.end(); ++it ) {
+        Clock* clock = it->second;
+
+        // The component may reregister with any of the clocks it
+        // could have used, so every one is made on the destination, in
+        // step with the source
+        if ( dst->clockMap.find(it->first) == dst->clockMap.end() ) {
+            Clock* copy = new Clock(clock->period);
+            copy->currentCycle = clock->currentCycle;
+            copy->next = clock->next;
+            dst->clockMap[it->first] = copy;
+            if ( clock->scheduled ) {
+                copy->scheduled = true;
+                copy->setDeliveryTime(clock->getDeliveryTime());
+                dst->timeVortex->insert(copy);
+            }
+        }
+
+        Clock::StaticHandlerMap_t& map = clock->staticHandlerMap;
+        for ( Clock::StaticHandlerMap_t::iterator h = map.begin(); h != map.end(); ) {
+            if ( handlers.count(*h) ) {
+                threads[to].handlers.push_back(std::make_pair(it->first, *h));
+                h = map.erase(h);
+            }
+            else {
+                ++h;
+            }
+        }
+    }
+}
+
+void
+ThreadLoadBalancer::addClockHandlers(int thread)
+{
+    // Registering may schedule the clock, which has to be done by the
+    // thread that owns it
+    std::vector<std::pair<SimTime_t, Clock::HandlerBase*> >& handlers = threads[thread].handlers;
+    Simulation* sim = Simulation::instanceVec[thread];
+    for ( size_t i = 0; i < handlers.size(); i++ ) {
+        sim->clockMap[handlers[i].first]->registerHandler(handlers[i].second);
+    }
+    handlers.clear();
+}
+
+} // namespace SST
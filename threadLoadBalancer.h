@@ -0,0 +1,154 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADLOADBALANCER_H
+#define SST_CORE_THREADLOADBALANCER_H
+
+#include "sst/core/sst_types.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "sst/core/clock.h"
+#include "sst/core/threadsafe.h"
+
+namespace SST {
+
+class Link;
+class Simulation;
+
+/**
+ * Moves components from busy threads to idle ones while the
+ * simulation runs.
+ *
+ * Every so many thread syncs, each thread adds up the time its
+ * components spent in their event and clock handlers (counted as for
+ * a partition profile).  If the busiest thread spent more than the
+ * threshold times the average, components are moved from it to the
+ * least busy thread until about half the difference has moved.
+ *
+ * A component is moved with its ComponentInfo and LinkMap, its clock
+ * handlers and the events in the TimeVortex waiting for it.  Its
+ * links are joined directly to the other side when that ends up on
+ * the same thread, and through the thread syncs otherwise.  Only
+ * components whose links stay on the rank, whose links to other
+ * threads have at least the inter-thread lookahead in both directions,
+ * and which have not registered a OneShot can be moved.  Statistics
+ * are still written by the thread the component started on.
+ *
+ * Used with ThreadSyncSimpleSkip, whose sync period is the smallest
+ * lookahead between any two threads.
+ */
+class ThreadLoadBalancer {
+public:
+    /** Create a balancer for the threads of this rank
+     * @param num_threads - number of threads on the rank
+     * @param threshold - ratio of the busiest thread's time to the
+     *        average above which components are moved
+     * @param barrier - barrier shared by the threads of the rank
+     */
+    ThreadLoadBalancer(int num_threads, double threshold, Core::ThreadSafe::Barrier& barrier);
+    ~ThreadLoadBalancer();
+
+    /** Record a component at wire-up */
+    void addComponent(ComponentId_t id, int thread);
+    /** Record one side of a link on this rank at wire-up
+     * @param id - ID of the link in the ConfigGraph
+     * @param side - which side of the link (0 or 1)
+     * @param comp - component on that side
+     * @param thread - thread of the component
+     * @param end - link in the LinkMap of the component
+     * @param stub - link registered with the thread sync for end, or
+     *        NULL if the other side is on the same thread
+     */
+    void addLink(LinkId_t id, int side, ComponentId_t comp, int thread, Link* end, Link* stub);
+    /** Keep a component on its thread for the rest of the run */
+    void pin(ComponentId_t id);
+
+    /** Called by every thread of the rank at each thread sync, after
+     * the events between threads have been delivered */
+    void execute(int thread);
+
+private:
+    struct component_t {
+        int thread;
+        double start;       // handler time at the start of the window
+        std::vector<LinkId_t> links;
+
+        component_t() : thread(-1), start(0.0) {}
+    };
+
+    struct link_t {
+        ComponentId_t comp[2];
+        int           thread[2];    // -1 for a side on another rank
+        Link*         end[2];
+        Link*         stub[2];
+        LinkId_t      index[2];     // sync index stub[i] is registered at
+
+        link_t() {
+            for ( int i = 0; i < 2; i++ ) {
+                comp[i] = 0;
+                thread[i] = -1;
+                end[i] = NULL;
+                stub[i] = NULL;
+                index[i] = 0;
+            }
+        }
+    };
+
+    struct cost_t {
+        ComponentId_t id;
+        double total;       // handler time since the start of the run
+        double window;      // handler time since the last balance
+
+        /** Most expensive first */
+        bool operator<(const cost_t& other) const { return window > other.window; }
+    };
+
+    struct thread_t {
+        uint64_t syncs;
+        double busy;
+        std::vector<cost_t> costs;
+        /** Clock handlers moved to the thread, by clock period */
+        std::vector<std::pair<SimTime_t, Clock::HandlerBase*> > handlers;
+
+        thread_t() : syncs(0), busy(0.0) {}
+    };
+
+    int num_threads;
+    double threshold;
+    Core::ThreadSafe::Barrier& barrier;
+    std::mutex wireup_mutex;
+    std::mutex pin_mutex;
+
+    std::unordered_map<ComponentId_t, component_t> components;
+    std::unordered_map<LinkId_t, link_t> links;
+    std::unordered_set<ComponentId_t> pinned;
+    std::vector<thread_t> threads;
+    bool window_done;
+    uint64_t moves;
+
+    void measure(int thread);
+    void balance();
+    bool canMove(ComponentId_t id, int to);
+    void move(ComponentId_t id, int from, int to, std::unordered_set<Link*>& moved_links);
+    void relink(LinkId_t id, const int old_thread[2]);
+    void moveEvents(int from, int to, const std::unordered_set<Link*>& moved_links);
+    void moveClocks(ComponentId_t id, int from, int to);
+    void addClockHandlers(int thread);
+};
+
+} // namespace SST
+
+#endif // SST_CORE_THREADLOADBALANCER_H
@@ -0,0 +1,139 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+#include "sst/core/threadPlacement.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+#ifndef SST_COMPILE_MACOSX
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+
+using namespace SST::Core;
+
+#ifndef SST_COMPILE_MACOSX
+/* Parse a sysfs cpulist ("0-7,16-23") into cpu numbers */
+static void parseCPUList(const char* path, std::vector<int>& cpus)
+{
+    FILE* fp = fopen(path, "r");
+    if ( fp == NULL ) return;
+
+    int first, last;
+    while ( fscanf(fp, "%d", &first) == 1 ) {
+        last = first;
+        int c = fgetc(fp);
+        if ( c == '-' ) {
+            if ( fscanf(fp, "%d", &last) != 1 ) break;
+            c = fgetc(fp);
+        }
+        for ( int i = first; i <= last; i++ ) cpus.push_back(i);
+        if ( c != ',' ) break;
+    }
+    fclose(fp);
+}
+#endif
+
+std::vector<int> SST::Core::getAllowedCPUs()
+{
+    std::vector<int> cpus;
+#ifndef SST_COMPILE_MACOSX
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if ( sched_getaffinity(0, sizeof(allowed), &allowed) != 0 ) return cpus;
+    for ( int cpu = 0; cpu < CPU_SETSIZE; cpu++ ) {
+        if ( CPU_ISSET(cpu, &allowed) ) cpus.push_back(cpu);
+    }
+#endif
+    return cpus;
+}
+
+std::vector<ThreadPlacement> SST::Core::computeThreadPlacement(uint32_t num_threads, uint32_t slice, uint32_t num_slices)
+{
+    ThreadPlacement unbound = { -1, -1 };
+    std::vector<ThreadPlacement> placement(num_threads, unbound);
+
+#ifndef SST_COMPILE_MACOSX
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if ( sched_getaffinity(0, sizeof(allowed), &allowed) != 0 ) return placement;
+
+    // Map each allowed cpu to its node.  Without NUMA information in
+    // sysfs, everything is on node 0.
+    std::map<int, int> cpu_node;
+    for ( int node = 0; node < CPU_SETSIZE; node++ ) {
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        std::vector<int> cpus;
+        parseCPUList(path, cpus);
+        if ( cpus.empty() ) {
+            if ( node > 0 ) break;
+            continue;
+        }
+        for ( size_t i = 0; i < cpus.size(); i++ ) {
+            if ( cpus[i] < CPU_SETSIZE && CPU_ISSET(cpus[i], &allowed) ) cpu_node[cpus[i]] = node;
+        }
+    }
+
+    // Allowed cpus, grouped by node
+    std::vector<ThreadPlacement> cpus;
+    std::map<int, std::vector<int> > by_node;
+    for ( int cpu = 0; cpu < CPU_SETSIZE; cpu++ ) {
+        if ( !CPU_ISSET(cpu, &allowed) ) continue;
+        std::map<int, int>::iterator it = cpu_node.find(cpu);
+        by_node[it == cpu_node.end() ? 0 : it->second].push_back(cpu);
+    }
+    for ( std::map<int, std::vector<int> >::iterator it = by_node.begin(); it != by_node.end(); ++it ) {
+        for ( size_t i = 0; i < it->second.size(); i++ ) {
+            ThreadPlacement p = { it->second[i], it->first };
+            cpus.push_back(p);
+        }
+    }
+    if ( cpus.empty() ) return placement;
+
+    // This rank's share of the cpus, at least one
+    if ( num_slices > 1 ) {
+        size_t first = ((uint64_t)slice * cpus.size()) / num_slices;
+        size_t last = ((uint64_t)(slice + 1) * cpus.size()) / num_slices;
+        if ( last <= first ) last = first + 1;
+        cpus = std::vector<ThreadPlacement>(cpus.begin() + first, cpus.begin() + last);
+    }
+
+    for ( uint32_t i = 0; i < num_threads; i++ ) {
+        if ( num_threads <= cpus.size() ) {
+            placement[i] = cpus[((uint64_t)i * cpus.size()) / num_threads];
+        }
+        else {
+            placement[i] = cpus[i % cpus.size()];
+        }
+    }
+#endif
+    return placement;
+}
+
+bool SST::Core::bindThreadToCPU(int cpu)
+{
+#ifndef SST_COMPILE_MACOSX
+    if ( cpu < 0 || cpu >= CPU_SETSIZE ) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
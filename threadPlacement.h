@@ -0,0 +1,56 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_CORE_THREADPLACEMENT
+#define _H_SST_CORE_THREADPLACEMENT
+
+#include <inttypes.h>
+#include <vector>
+
+namespace SST {
+namespace Core {
+
+/** Where a simulation thread runs */
+struct ThreadPlacement {
+    int cpu;    /*!< CPU the thread is bound to, -1 if not bound */
+    int node;   /*!< NUMA node of that CPU, -1 if unknown */
+};
+
+/** Return the CPUs this process is allowed to run on, in order */
+std::vector<int> getAllowedCPUs();
+
+/**
+ * Choose a CPU for each of num_threads simulation threads from the
+ * CPUs this process is allowed to run on.  CPUs are ordered by NUMA
+ * node and threads are spread evenly over that list, so consecutive
+ * threads share a node and each node gets a share of the threads
+ * proportional to its CPU count.
+ *
+ * When several ranks on a node are allowed the same CPUs, the list is
+ * cut into num_slices contiguous slices and the threads are spread
+ * over slice number slice only, so the ranks don't share cores.
+ */
+std::vector<ThreadPlacement> computeThreadPlacement(uint32_t num_threads, uint32_t slice = 0, uint32_t num_slices = 1);
+
+/**
+ * Bind the calling thread to a CPU.  Threads created afterwards by
+ * the calling thread inherit the binding, and memory they touch first
+ * is allocated on the local node.
+ * @return false if the binding failed or is not supported
+ */
+bool bindThreadToCPU(int cpu);
+
+}
+}
+
+
+#endif
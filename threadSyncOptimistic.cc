@@ -0,0 +1,239 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/threadSyncOptimistic.h"
+
+#include "sst/core/event.h"
+#include "sst/core/exit.h"
+#include "sst/core/link.h"
+#include "sst/core/output.h"
+#include "sst/core/simulation.h"
+
+namespace SST {
+
+Core::ThreadSafe::Barrier ThreadSyncOptimistic::barrier;
+std::atomic<bool> ThreadSyncOptimistic::straggler(false);
+std::atomic<bool> ThreadSyncOptimistic::veto(false);
+std::atomic<bool> ThreadSyncOptimistic::unsupported(false);
+
+ThreadSyncOptimistic::ThreadSyncOptimistic(int num_threads, int thread, Simulation* sim, SimTime_t window) :
+    NewThreadSync(),
+    window(window),
+    num_threads(num_threads),
+    thread(thread),
+    sim(sim),
+    speculating(false),
+    disabled(false),
+    conservative_until(0),
+    windows(0),
+    rollbacks(0),
+    totalWaitTime(0.0),
+    totalSleepTime(0.0)
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues.push_back(new ThreadSyncQueue());
+    }
+    links.resize(num_threads);
+
+    if ( thread == 0 ) {
+        barrier.resize(num_threads);
+        barrier.setHybrid(Simulation::isHybridBarrier());
+        barrier.setTree(Simulation::isTreeBarrier());
+    }
+
+    exit = sim->getExit();
+    max_period = sim->getInterThreadMinLatency();
+    nextSyncTime = max_period;
+}
+
+ThreadSyncOptimistic::~ThreadSyncOptimistic()
+{
+    if ( windows > 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncOptimistic %" PRIu64 " speculative windows, %" PRIu64 " rolled back\n", windows, rollbacks);
+    if ( totalWaitTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncOptimistic total wait time: %lg seconds (%lg seconds asleep).\n", totalWaitTime, totalSleepTime);
+    for ( int i = 0; i < num_threads; i++ ) {
+        delete queues[i];
+    }
+    queues.clear();
+}
+
+void
+ThreadSyncOptimistic::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
+{
+    std::vector<Link*>& vec = links[to_rank.thread];
+    setSyncIndex(link, vec.size());
+    vec.push_back(link);
+}
+
+ActivityQueue*
+ThreadSyncOptimistic::getQueueForThread(int tid)
+{
+    return queues[tid];
+}
+
+void
+ThreadSyncOptimistic::deliverEvents()
+{
+    SimTime_t current_cycle = sim->getCurrentSimCycle();
+    for ( int i = 0; i < num_threads; i++ ) {
+        std::vector<Activity*>& vec = queues[i]->getVector();
+        std::vector<Link*>& link_vec = links[i];
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            Event* ev = static_cast<Event*>(vec[j]);
+            // Events carry the sync index of their link
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            link_vec[ev->getSyncIndex()]->send(delay,ev);
+        }
+        queues[i]->clear();
+    }
+}
+
+void
+ThreadSyncOptimistic::dropEvents()
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        std::vector<Activity*>& vec = queues[i]->getVector();
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            delete vec[j];
+        }
+        queues[i]->clear();
+    }
+}
+
+void
+ThreadSyncOptimistic::before()
+{
+    // SyncManager barriers before and after this call
+    deliverEvents();
+}
+
+void
+ThreadSyncOptimistic::after()
+{
+    nextSyncTime = sim->getLocalMinimumNextActivityTime() + max_period;
+    totalWaitTime += barrier.wait(totalSleepTime);
+}
+
+bool
+ThreadSyncOptimistic::startWindow()
+{
+    SimTime_t current = sim->getCurrentSimCycle();
+
+    // All threads are in the sync, so nothing changes the exit counts
+    // while they are saved
+    Simulation::CheckpointResult_t result = sim->saveCheckpoint(current + window);
+    if ( thread == 0 ) exit->saveCheckpoint();
+    if ( result != Simulation::CHECKPOINT_OK ) veto = true;
+    if ( result == Simulation::CHECKPOINT_UNSUPPORTED && !unsupported.exchange(true) ) {
+        sim->getSimulationOutput().output("WARNING: Can't run optimistically, %s.  Running conservatively.\n",
+                                          sim->getCheckpointProblem().c_str());
+    }
+
+    totalWaitTime += barrier.wait(totalSleepTime);
+    bool start = !veto;
+    bool stop_speculating = unsupported;
+    totalWaitTime += barrier.wait(totalSleepTime);
+    if ( thread == 0 ) veto = false;
+
+    if ( start ) {
+        speculating = true;
+        windows++;
+        nextSyncTime = current + window;
+        return true;
+    }
+
+    sim->discardCheckpoint();
+    if ( stop_speculating ) disabled = true;
+    return false;
+}
+
+void
+ThreadSyncOptimistic::execute()
+{
+    SimTime_t current = sim->getCurrentSimCycle();
+    totalWaitTime += barrier.wait(totalSleepTime);
+
+    if ( speculating ) {
+        speculating = false;
+
+        // Anything sent to this thread during the window that was due
+        // before its end arrived too late
+        for ( int i = 0; i < num_threads; i++ ) {
+            std::vector<Activity*>& vec = queues[i]->getVector();
+            for ( size_t j = 0; j < vec.size(); j++ ) {
+                if ( vec[j]->getDeliveryTime() < current ) straggler = true;
+            }
+        }
+        totalWaitTime += barrier.wait(totalSleepTime);
+        bool rollback = straggler;
+        totalWaitTime += barrier.wait(totalSleepTime);
+        if ( thread == 0 ) straggler = false;
+
+        if ( rollback ) {
+            // Everything sent during the window is dropped, then the
+            // window is run again conservatively
+            dropEvents();
+            if ( thread == 0 ) exit->restoreCheckpoint();
+            sim->restoreCheckpoint();
+            rollbacks++;
+            conservative_until = current;
+            current = sim->getCurrentSimCycle();
+        }
+        else {
+            sim->discardCheckpoint();
+            deliverEvents();
+        }
+    }
+    else {
+        deliverEvents();
+    }
+
+    // Make sure every queue is empty and every thread has its state
+    // back before looking at the TimeVortices
+    totalWaitTime += barrier.wait(totalSleepTime);
+
+    if ( !disabled && current >= conservative_until ) {
+        if ( startWindow() ) return;
+    }
+
+    nextSyncTime = sim->getLocalMinimumNextActivityTime() + max_period;
+    totalWaitTime += barrier.wait(totalSleepTime);
+}
+
+void
+ThreadSyncOptimistic::processLinkInitData()
+{
+    // Need to walk through all the queues and send the data to the
+    // correct links
+    for ( int i = 0; i < num_threads; i++ ) {
+        std::vector<Activity*>& vec = queues[i]->getVector();
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            Event* ev = static_cast<Event*>(vec[j]);
+            sendInitData_sync(links[i][ev->getSyncIndex()],ev);
+        }
+        queues[i]->clear();
+    }
+}
+
+void
+ThreadSyncOptimistic::finalizeLinkConfigurations()
+{
+    for ( size_t i = 0; i < links.size(); i++ ) {
+        for ( size_t j = 0; j < links[i].size(); j++ ) {
+            finalizeConfiguration(links[i][j]);
+        }
+    }
+}
+
+} // namespace SST
@@ -0,0 +1,120 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCOPTIMISTIC_H
+#define SST_CORE_THREADSYNCOPTIMISTIC_H
+
+#include "sst/core/sst_types.h"
+
+#include <atomic>
+#include <vector>
+
+#include "sst/core/syncManager.h"
+#include "sst/core/threadSyncQueue.h"
+#include "sst/core/threadsafe.h"
+
+namespace SST {
+
+class Exit;
+class Link;
+class Simulation;
+
+/**
+ * Thread sync that runs windows longer than the inter-thread lookahead
+ * speculatively.  EXPERIMENTAL, selected with --optimistic-window.
+ *
+ * At the start of a window every thread saves its state (see
+ * Simulation::saveCheckpoint()) and then runs to the end of the window
+ * without syncing.  Events sent to other threads are held in the
+ * queues until the end of the window.  If any of them is due before
+ * the end of the window it arrived too late, and every thread goes
+ * back to the start of the window and runs it again conservatively.
+ * Otherwise the window is committed and the held events are
+ * delivered.
+ *
+ * This is a window-wide rollback, not Time Warp.  There are no
+ * anti-messages, no per-component rollback and no fossil collection
+ * beyond dropping the last checkpoint, so a single late event costs
+ * every thread the whole window.  Saving a checkpoint drains and
+ * refills the TimeVortex and copies every pending Event, so each
+ * window costs time proportional to the number of pending events.
+ * Rolling back does not undo:
+ *  - output written by components during the window;
+ *  - Actions other than clocks and one shots scheduled during the
+ *    window, which are dropped.
+ *
+ * If any component can't save its state, a component has a polling
+ * link, or statistics are output before the end of the simulation, all
+ * windows are run conservatively, as with ThreadSyncSimpleSkip.
+ * Windows in which the simulation stops are also run conservatively.
+ * Pending Events are saved with the core serializer, so every Event
+ * type sent on a link must implement serialization itself.
+ *
+ * Only used for single rank simulations.
+ */
+class ThreadSyncOptimistic : public NewThreadSync {
+public:
+    /** Create a new ThreadSync object
+     * @param window - length of the speculative windows in core cycles
+     */
+    ThreadSyncOptimistic(int num_threads, int thread, Simulation* sim, SimTime_t window);
+    ~ThreadSyncOptimistic();
+
+    void before();
+    void after();
+    void execute(void);
+
+    /** Cause an exchange of Initialization Data to occur */
+    void processLinkInitData();
+    /** Finish link configuration */
+    void finalizeLinkConfigurations();
+
+    /** Register a Link which this Sync Object is responsible for */
+    void registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link);
+    ActivityQueue* getQueueForThread(int tid);
+
+private:
+    /** Send the events in the queues on to their links */
+    void deliverEvents();
+    /** Delete the events in the queues */
+    void dropEvents();
+    /** Try to start a speculative window at the current time.
+     * Returns true if every thread started one. */
+    bool startWindow();
+
+    std::vector<ThreadSyncQueue*> queues;
+    std::vector<std::vector<Link*> > links;   // by thread, then by sync index
+    SimTime_t max_period;
+    SimTime_t window;
+    int num_threads;
+    int thread;
+    Simulation* sim;
+    Exit* exit;
+
+    bool speculating;
+    bool disabled;                  // some component can't save its state
+    SimTime_t conservative_until;   // end of the last window rolled back
+
+    uint64_t windows;
+    uint64_t rollbacks;
+    double totalWaitTime;
+    double totalSleepTime;
+
+    static Core::ThreadSafe::Barrier barrier;
+    static std::atomic<bool> straggler;
+    static std::atomic<bool> veto;
+    static std::atomic<bool> unsupported;
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCOPTIMISTIC_H
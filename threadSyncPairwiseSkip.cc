@@ -0,0 +1,199 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/threadSyncPairwiseSkip.h"
+
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/output.h"
+#include "sst/core/profile.h"
+#include "sst/core/simulation.h"
+
+#include <thread>
+
+namespace SST {
+
+std::mutex ThreadSyncPairwiseSkip::instanceMutex;
+std::vector<ThreadSyncPairwiseSkip*> ThreadSyncPairwiseSkip::instances;
+
+ThreadSyncPairwiseSkip::ThreadSyncPairwiseSkip(int num_threads, int thread, Simulation* sim, const std::vector<SimTime_t>& latencies) :
+    NewThreadSync(),
+    num_threads(num_threads),
+    thread(thread),
+    sim(sim),
+    totalWaitTime(0.0)
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues.push_back(new PairQueue());
+    }
+    links.resize(num_threads);
+
+    SimTime_t min_latency = MAX_SIMTIME_T;
+    for ( int i = 0; i < num_threads; i++ ) {
+        if ( i == thread || latencies[i] == MAX_SIMTIME_T ) continue;
+        neighbor_t neighbor;
+        neighbor.thread = i;
+        neighbor.latency = latencies[i];
+        neighbors.push_back(neighbor);
+        if ( latencies[i] < min_latency ) min_latency = latencies[i];
+    }
+
+    // Every thread starts at time 0, so the first window is set by the
+    // closest neighbor
+    published.time.store(0);
+    nextSyncTime = min_latency;
+
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if ( instances.size() < (size_t)num_threads ) instances.resize(num_threads, NULL);
+    instances[thread] = this;
+}
+
+ThreadSyncPairwiseSkip::~ThreadSyncPairwiseSkip()
+{
+    if ( totalWaitTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncPairwiseSkip total wait time: %lg seconds.\n", totalWaitTime);
+    for ( int i = 0; i < num_threads; i++ ) {
+        delete queues[i];
+    }
+    queues.clear();
+}
+
+void
+ThreadSyncPairwiseSkip::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
+{
+    std::vector<Link*>& vec = links[to_rank.thread];
+    setSyncIndex(link, vec.size());
+    vec.push_back(link);
+}
+
+ActivityQueue*
+ThreadSyncPairwiseSkip::getQueueForThread(int tid)
+{
+    return queues[tid];
+}
+
+void
+ThreadSyncPairwiseSkip::deliverEvents()
+{
+    // Only neighbors have links to this thread
+    SimTime_t current_cycle = sim->getCurrentSimCycle();
+    for ( size_t i = 0; i < neighbors.size(); i++ ) {
+        queues[neighbors[i].thread]->take(drain);
+        std::vector<Link*>& link_vec = links[neighbors[i].thread];
+        for ( size_t j = 0; j < drain.size(); j++ ) {
+            Event* ev = static_cast<Event*>(drain[j]);
+            // Events carry the sync index of their link
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            link_vec[ev->getSyncIndex()]->send(delay,ev);
+        }
+        drain.clear();
+    }
+}
+
+void
+ThreadSyncPairwiseSkip::before()
+{
+    // All threads are stopped in the SyncManager barrier, so the
+    // queues can just be emptied
+    deliverEvents();
+}
+
+void
+ThreadSyncPairwiseSkip::after()
+{
+    execute();
+}
+
+void
+ThreadSyncPairwiseSkip::execute()
+{
+    SimTime_t current = sim->getCurrentSimCycle();
+
+    // Nothing this thread sends from now on can be earlier than the
+    // current time
+    publish(current);
+
+    // Wait until every neighbor's bound lets this thread move past
+    // the current time.  The thread with the lowest bound never
+    // waits, so this can't deadlock.  Yield now and then, in case
+    // that thread is waiting for this core.
+    auto waitStart = SST::Core::Profile::now();
+    SimTime_t bound;
+    uint32_t spins = 0;
+    while ( true ) {
+        bound = MAX_SIMTIME_T;
+        for ( size_t i = 0; i < neighbors.size(); i++ ) {
+            const neighbor_t& neighbor = neighbors[i];
+            SimTime_t time = instances[neighbor.thread]->published.time.load(std::memory_order_acquire);
+            SimTime_t limit;
+            if ( time == MAX_SIMTIME_T ) {
+                // Neighbor has stopped and sends nothing more, but
+                // keep syncing so the exit is still checked
+                limit = current + neighbor.latency;
+            }
+            else if ( time > MAX_SIMTIME_T - neighbor.latency ) {
+                limit = MAX_SIMTIME_T;
+            }
+            else {
+                limit = time + neighbor.latency;
+            }
+            if ( limit < bound ) bound = limit;
+        }
+        if ( bound > current ) break;
+        if ( ++spins % 1024 == 0 ) std::this_thread::yield();
+        else _mm_pause();
+    }
+    totalWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+    // Everything the neighbors sent before publishing the bounds just
+    // read is now in the queues
+    deliverEvents();
+    nextSyncTime = bound;
+
+    // Until the next sync this thread only runs what is already in
+    // its TimeVortex
+    SimTime_t next = sim->getNextActivityTime();
+    publish(next < bound ? next : bound);
+}
+
+void
+ThreadSyncPairwiseSkip::finish()
+{
+    publish(MAX_SIMTIME_T);
+}
+
+void
+ThreadSyncPairwiseSkip::processLinkInitData()
+{
+    // Need to walk through all the queues and send the data to the
+    // correct links
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues[i]->take(drain);
+        for ( size_t j = 0; j < drain.size(); j++ ) {
+            Event* ev = static_cast<Event*>(drain[j]);
+            sendInitData_sync(links[i][ev->getSyncIndex()],ev);
+        }
+        drain.clear();
+    }
+}
+
+void
+ThreadSyncPairwiseSkip::finalizeLinkConfigurations() {
+    for ( size_t i = 0; i < links.size(); i++ ) {
+        for ( size_t j = 0; j < links[i].size(); j++ ) {
+            finalizeConfiguration(links[i][j]);
+        }
+    }
+}
+
+} // namespace SST
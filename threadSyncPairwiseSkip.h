@@ -0,0 +1,125 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCPAIRWISESKIP_H
+#define SST_CORE_THREADSYNCPAIRWISESKIP_H
+
+#include "sst/core/sst_types.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "sst/core/activityQueue.h"
+#include "sst/core/syncManager.h"
+#include "sst/core/threadsafe.h"
+
+namespace SST {
+
+class Link;
+class Simulation;
+
+/**
+ * Thread sync that only waits on the threads that can affect this one.
+ *
+ * Each thread publishes a lower bound on the time of anything it may
+ * still send.  A thread that has a link to thread j with minimum
+ * latency L can run up to (j's bound + L) without hearing from j
+ * again, so at each sync it waits only until every neighbor's bound
+ * allows some progress, and the next sync is set by the closest
+ * neighbor.  Threads with no links between them never wait on each
+ * other, and a short-latency link only affects its two endpoints.
+ *
+ * Only used for single rank simulations.  The rank syncs barrier all
+ * threads together, which would undo this.
+ */
+class ThreadSyncPairwiseSkip : public NewThreadSync, public Core::ThreadSafe::CacheAlignedNew {
+public:
+    /** Create a new ThreadSync object
+     * @param latencies - minimum link latency to each other thread,
+     * MAX_SIMTIME_T if there are no links to it
+     */
+    ThreadSyncPairwiseSkip(int num_threads, int thread, Simulation* sim, const std::vector<SimTime_t>& latencies);
+    ~ThreadSyncPairwiseSkip();
+
+    void before();
+    void after();
+    void execute(void);
+    void finish();
+
+    /** Cause an exchange of Initialization Data to occur */
+    void processLinkInitData();
+    /** Finish link configuration */
+    void finalizeLinkConfigurations();
+
+    /** Register a Link which this Sync Object is responsible for */
+    void registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link);
+    ActivityQueue* getQueueForThread(int tid);
+
+private:
+    /** Queue for the events from one neighbor.  The neighbor is the
+     * only producer and this thread the only consumer, so events can
+     * be taken while the neighbor is still running. */
+    class PairQueue : public ActivityQueue, public Core::ThreadSafe::CacheAlignedNew {
+    public:
+        PairQueue() : ActivityQueue() {}
+        ~PairQueue() {}
+
+        bool empty() { return lane.empty(); }
+        int size() { return lane.size(); }
+        void insert(Activity* activity) { lane.insert(activity); }
+        /** Not supported */
+        Activity* pop() { return NULL; }
+        /** Not supported */
+        Activity* front() { return NULL; }
+
+        /** Append the queued activities to vec */
+        void take(std::vector<Activity*>& vec) { lane.take(vec); }
+
+    private:
+        Core::ThreadSafe::SPSCQueue<Activity*> lane;
+    };
+
+    /** Send the events in the queues on to their links */
+    void deliverEvents();
+    /** Set the bound on what this thread may still send */
+    void publish(SimTime_t time) {
+        published.time.store(time, std::memory_order_release);
+    }
+
+    struct neighbor_t {
+        int thread;
+        SimTime_t latency;
+    };
+
+    // Kept on its own cache line, since other threads poll it
+    struct alignas(64) published_t {
+        std::atomic<SimTime_t> time;
+    };
+
+    std::vector<PairQueue*> queues;
+    std::vector<neighbor_t> neighbors;
+    std::vector<Activity*> drain;
+    std::vector<std::vector<Link*> > links;   // by thread, then by sync index
+    published_t published;
+    int num_threads;
+    int thread;
+    Simulation* sim;
+    double totalWaitTime;
+
+    static std::mutex instanceMutex;
+    static std::vector<ThreadSyncPairwiseSkip*> instances;
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCPAIRWISESKIP_H
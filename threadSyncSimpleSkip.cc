@@ -30,15 +30,21 @@ ThreadSyncSimpleSkip::ThreadSyncSimpleSkip(int num_threads, int thread, Simulati
     num_threads(num_threads),
     thread(thread),
     sim(sim),
-    totalWaitTime(0.0)
+    totalWaitTime(0.0),
+    totalSleepTime(0.0)
 {
     // TraceFunction trace(CALL_INFO_LONG);
     for ( int i = 0; i < num_threads; i++ ) {
         queues.push_back(new ThreadSyncQueue());
     }
+    links.resize(num_threads);
+    free_indices.resize(num_threads);
 
-    if ( sim->getRank().thread == 0 )
+    if ( sim->getRank().thread == 0 ) {
         barrier.resize(num_threads);
+        barrier.setHybrid(Simulation::isHybridBarrier());
+        barrier.setTree(Simulation::isTreeBarrier());
+    }
 
     if ( sim->getNumRanks().rank > 1 ) single_rank = false;
     else single_rank = true;
@@ -51,7 +57,7 @@ ThreadSyncSimpleSkip::~ThreadSyncSimpleSkip()
 {
     // TraceFunction trace(CALL_INFO_LONG);
     if ( totalWaitTime > 0.0 )
-        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncSimpleSkip total wait time: %lg seconds.\n", totalWaitTime);
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncSimpleSkip total wait time: %lg seconds (%lg seconds asleep).\n", totalWaitTime, totalSleepTime);
     for ( int i = 0; i < num_threads; i++ ) {
         delete queues[i];
     }
@@ -68,10 +74,27 @@ ThreadSyncSimpleSkip::~ThreadSyncSimpleSkip()
 // }
 
 void
-ThreadSyncSimpleSkip::registerLink(LinkId_t link_id, Link* link)
+ThreadSyncSimpleSkip::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
 {
-    // TraceFunction trace(CALL_INFO_LONG);
-    link_map[link_id] = link;
+    std::vector<Link*>& vec = links[to_rank.thread];
+    std::vector<LinkId_t>& free = free_indices[to_rank.thread];
+    // Indices are only freed during the run, so links registered at
+    // wire-up still get the same index on both sides
+    if ( !free.empty() ) {
+        setSyncIndex(link, free.back());
+        vec[free.back()] = link;
+        free.pop_back();
+        return;
+    }
+    setSyncIndex(link, vec.size());
+    vec.push_back(link);
+}
+
+void
+ThreadSyncSimpleSkip::unregisterLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t index)
+{
+    links[to_rank.thread][index] = NULL;
+    free_indices[to_rank.thread].push_back(index);
 }
 
 ActivityQueue*
@@ -94,19 +117,16 @@ ThreadSyncSimpleSkip::before()
     // if ( disabled ) return;
 
     // Empty all the queues and send events on the links
+    SimTime_t current_cycle = sim->getCurrentSimCycle();
     for ( int i = 0; i < queues.size(); i++ ) {
         ThreadSyncQueue* queue = queues[i];
         std::vector<Activity*>& vec = queue->getVector();
+        std::vector<Link*>& link_vec = links[i];
         for ( int j = 0; j < vec.size(); j++ ) {
             Event* ev = static_cast<Event*>(vec[j]);
-            auto link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
-                abort();
-            } else {
-                SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
-                link->second->send(delay,ev);
-            }
+            // Events carry the sync index of their link
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            link_vec[ev->getSyncIndex()]->send(delay,ev);
         }
         queue->clear();
     }
@@ -139,7 +159,7 @@ ThreadSyncSimpleSkip::after()
     // totalWaitTime += barrier.wait();
     // nextSyncTime = localMinimumNextActivityTime + max_period;
     nextSyncTime = sim->getLocalMinimumNextActivityTime() + max_period;
-    totalWaitTime += barrier.wait();
+    totalWaitTime += barrier.wait(totalSleepTime);
 
 }
 
@@ -148,9 +168,9 @@ ThreadSyncSimpleSkip::execute()
 {
     // TraceFunction trace(CALL_INFO_LONG);
 
-    totalWaitTime = barrier.wait();
+    totalWaitTime += barrier.wait(totalSleepTime);
     before();
-    totalWaitTime = barrier.wait();
+    totalWaitTime += barrier.wait(totalSleepTime);
     after();
     
 
@@ -200,14 +220,7 @@ ThreadSyncSimpleSkip::processLinkInitData()
         std::vector<Activity*>& vec = queue->getVector();
         for ( int j = 0; j < vec.size(); j++ ) {
             Event* ev = static_cast<Event*>(vec[j]);
-            auto link = link_map.find(ev->getLinkId());
-            if (link == link_map.end()) {
-                printf("Link not found in map!\n");
-                abort();
-            } else {
-                // link->second->sendInitData_sync(ev);
-                sendInitData_sync(link->second,ev);
-            }
+            sendInitData_sync(links[i][ev->getSyncIndex()],ev);
         }
         queue->clear();
     }
@@ -216,9 +229,10 @@ ThreadSyncSimpleSkip::processLinkInitData()
 void
 ThreadSyncSimpleSkip::finalizeLinkConfigurations() {
     // TraceFunction trace(CALL_INFO_LONG);
-    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
-        // i->second->finalizeConfiguration();
-        finalizeConfiguration(i->second);
+    for ( size_t i = 0; i < links.size(); i++ ) {
+        for ( size_t j = 0; j < links[i].size(); j++ ) {
+            finalizeConfiguration(links[i][j]);
+        }
     }
 }
 
@@ -15,7 +15,7 @@
 #include "sst/core/sst_types.h"
 #include <sst/core/serialization.h>
 
-#include <unordered_map>
+#include <vector>
 
 #include "sst/core/action.h"
 #include "sst/core/syncManager.h"
@@ -49,7 +49,8 @@ public:
     void finalizeLinkConfigurations();
 
     /** Register a Link which this Sync Object is responsible for */
-    void registerLink(LinkId_t link_id, Link* link);
+    void registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link);
+    void unregisterLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t index);
     ActivityQueue* getQueueForThread(int tid);
 
     uint64_t getDataSize() const;
@@ -58,7 +59,8 @@ public:
 
 private:
     std::vector<ThreadSyncQueue*> queues;
-    std::unordered_map<LinkId_t, Link*> link_map;
+    std::vector<std::vector<Link*> > links;   // by thread, then by sync index
+    std::vector<std::vector<LinkId_t> > free_indices;   // by thread
     SimTime_t max_period;
     int num_threads;
     int thread;
@@ -67,6 +69,7 @@ private:
     // static bool disabled;
     static Core::ThreadSafe::Barrier barrier;
     double totalWaitTime;
+    double totalSleepTime;
     bool single_rank;
 };
 
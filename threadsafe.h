@@ -19,10 +19,23 @@
 #include <condition_variable>
 #include <mutex>
 
+#include <algorithm>
 #include <vector>
 //#include <stdalign.h>
 
 #include <sched.h>
+#include <cinttypes>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include <sst/core/profile.h>
 
@@ -38,62 +51,283 @@ namespace ThreadSafe {
 #    define CACHE_ALIGNED_T alignas(64)
 #endif
 
+/**
+ * Base for classes with cache aligned members that are created with
+ * new.  Before C++17 the global operator new only guarantees the
+ * alignment of max_align_t, so those members could share a line.
+ */
+struct CacheAlignedNew {
+    static void* operator new(size_t size) {
+        void* mem = NULL;
+        if ( posix_memalign(&mem, 64, size) != 0 ) throw std::bad_alloc();
+        return mem;
+    }
+    static void operator delete(void* mem) {
+        free(mem);
+    }
+};
+
 
 class Barrier {
     size_t origCount;
     std::atomic<bool> enabled;
     std::atomic<size_t> count, generation;
+
+    /* Hybrid mode: spin for a while, then sleep */
+    bool hybrid;
+    std::atomic<uint32_t> sleepers;
+    std::atomic<uint32_t> wakeWord;     /* low bits of generation, futex word */
+    std::atomic<uint64_t> avgWait;      /* recent wait time, in TSC cycles */
+#ifndef __linux__
+    std::mutex sleepLock;
+    std::condition_variable sleepCond;
+#endif
+
+    /* Waits shorter than this are spun through.  Longer ones sleep
+     * after MIN_SPIN cycles. */
+    static const uint64_t MAX_SPIN = 200000;
+    static const uint64_t MIN_SPIN = 2000;
+
+    /* Tree mode: threads arrive at the leaves of a combining tree
+     * instead of all decrementing count.  The last thread to arrive
+     * at a node goes on to its parent, and the last one at the root
+     * releases everybody. */
+    struct tree_node_t {
+        std::atomic<uint32_t> count;
+        uint32_t fanin;
+        int parent;         /* -1 for the root */
+        char pad[64 - sizeof(std::atomic<uint32_t>) - sizeof(uint32_t) - sizeof(int)];
+    };
+    static const uint32_t TREE_RADIX = 4;
+    bool tree;
+    tree_node_t* nodes;
+
 public:
     Barrier(size_t count) : origCount(count), enabled(true),
-            count(count), generation(0)
+            count(count), generation(0), hybrid(false), sleepers(0),
+            wakeWord(0), avgWait(0), tree(false), nodes(NULL)
     { }
 
     // Come g++ 4.7, this can become a delegating constructor
-    Barrier() : origCount(0), enabled(false), count(0), generation(0)
+    Barrier() : origCount(0), enabled(false), count(0), generation(0),
+            hybrid(false), sleepers(0), wakeWord(0), avgWait(0), tree(false), nodes(NULL)
     { }
 
+    ~Barrier()
+    {
+        delete[] nodes;
+    }
+
 
     /** ONLY call this while nobody is in wait() */
     void resize(size_t newCount)
     {
         count = origCount = newCount;
         generation.store(0);
+        wakeWord.store(0);
         enabled.store(true);
+        if ( tree ) buildTree();
     }
 
+    /** Use a combining tree, so that threads don't all update the same
+     * cache line.  Every thread that waits must have called
+     * setThreadIndex() with a different index below the count, so only
+     * barriers waited on by the simulation threads of a rank (whose
+     * index is their thread number) may use it.  A thread without a
+     * valid index aborts in wait().  ONLY call this while nobody is in
+     * wait() */
+    void setTree(bool t)
+    {
+        tree = t;
+        if ( tree ) buildTree();
+    }
+    bool isTree() const { return tree; }
+
+    /** Set the index of the calling thread, used by tree barriers */
+    static void setThreadIndex(uint32_t index) { threadIndex() = index; }
+
+    /** Number of times the calling thread has waited at any Barrier */
+    static uint64_t getWaitCount() { return waitCount(); }
+
+    /** Spin for a budget based on recent wait times, then sleep,
+     * instead of spinning until released.  ONLY call this while nobody
+     * is in wait() */
+    void setHybrid(bool h) { hybrid = h; }
+    bool isHybrid() const { return hybrid; }
+
 
     /**
      * Wait for all threads to reach this point.
+     * @param sleepTime - incremented by the part of the wait spent
+     * asleep, if configured with --enable-profile
      * @return 0.0, or elapsed time spent waiting, if configured with --enable-profile
      */
-    double wait()
+    double wait(double& sleepTime)
     {
         double elapsed = 0.0;
         if ( enabled ) {
             auto startTime = SST::Core::Profile::now();
+            waitCount()++;
 
             size_t gen = generation.load();
-            size_t c = --count;
-            if ( 0 == c ) {
+            if ( arrive() ) {
                 /* We should release */
-                count = origCount;
-                ++generation; /* Incrementing generation causes release */
-            } else {
+                release();
+            } else if ( !hybrid ) {
                 /* Try spinning first */
                 do {
                     _mm_pause();
                 } while ( gen == generation.load(std::memory_order_acquire) );
+            } else {
+                uint64_t avg = avgWait.load(std::memory_order_relaxed);
+                uint64_t budget = MIN_SPIN;
+                if ( avg <= MAX_SPIN && 2 * avg > budget ) budget = 2 * avg;
+
+                uint64_t start = __rdtsc();
+                uint64_t waited;
+                while ( true ) {
+                    _mm_pause();
+                    waited = __rdtsc() - start;
+                    if ( gen != generation.load(std::memory_order_acquire) ) break;
+                    if ( waited > budget ) {
+                        auto sleepStart = SST::Core::Profile::now();
+                        sleep(gen);
+                        sleepTime += SST::Core::Profile::getElapsed(sleepStart);
+                        waited = __rdtsc() - start;
+                        break;
+                    }
+                }
+                /* Moving average over the last several waits.  Racy
+                 * updates just lose a sample. */
+                avgWait.store(avg - avg / 8 + waited / 8, std::memory_order_relaxed);
             }
             elapsed = SST::Core::Profile::getElapsed(startTime);
         }
         return elapsed;
     }
 
+    /**
+     * Wait for all threads to reach this point.
+     * @return 0.0, or elapsed time spent waiting, if configured with --enable-profile
+     */
+    double wait()
+    {
+        double sleepTime = 0.0;
+        return wait(sleepTime);
+    }
+
     void disable()
     {
         enabled.store(false);
         count.store(0);
-        ++generation;
+        release();
+    }
+
+private:
+    static uint32_t& threadIndex()
+    {
+        static thread_local uint32_t index = UINT32_MAX;
+        return index;
+    }
+
+    static uint64_t& waitCount()
+    {
+        static thread_local uint64_t count = 0;
+        return count;
+    }
+
+    void buildTree()
+    {
+        /* Leaves first, then each level above, up to the root */
+        std::vector<size_t> widths;
+        size_t width = origCount;
+        do {
+            width = (width + TREE_RADIX - 1) / TREE_RADIX;
+            widths.push_back(width);
+        } while ( width > 1 );
+
+        size_t total = 0;
+        for ( size_t i = 0; i < widths.size(); i++ ) total += widths[i];
+        delete[] nodes;
+        nodes = new tree_node_t[total];
+
+        size_t children = origCount;
+        size_t start = 0;
+        for ( size_t level = 0; level < widths.size(); level++ ) {
+            size_t next = start + widths[level];
+            for ( size_t i = 0; i < widths[level]; i++ ) {
+                tree_node_t& node = nodes[start + i];
+                node.fanin = (uint32_t)std::min<size_t>(TREE_RADIX, children - i * TREE_RADIX);
+                node.count.store(node.fanin);
+                node.parent = (level + 1 < widths.size()) ? (int)(next + i / TREE_RADIX) : -1;
+            }
+            children = widths[level];
+            start = next;
+        }
+    }
+
+    /* Returns true for the last thread to arrive */
+    bool arrive()
+    {
+        if ( !tree ) {
+            if ( 0 != --count ) return false;
+            count = origCount;
+            return true;
+        }
+
+        /* Two threads on one leaf slot would release the barrier early
+         * or never */
+        uint32_t index = threadIndex();
+        if ( index >= origCount ) {
+            fprintf(stderr, "FATAL: thread index %" PRIu32 " is not below the count (%zu) of a tree Barrier.  "
+                    "Call Barrier::setThreadIndex() in every thread that waits on it.\n", index, origCount);
+            abort();
+        }
+        int n = (int)(index / TREE_RADIX);
+        while ( n != -1 ) {
+            tree_node_t& node = nodes[n];
+            if ( 0 != --node.count ) return false;
+            /* Nobody comes back to this node until the release */
+            node.count.store(node.fanin, std::memory_order_relaxed);
+            n = node.parent;
+        }
+        return true;
+    }
+
+    void release()
+    {
+        ++generation; /* Incrementing generation causes release */
+        wakeWord.store((uint32_t)generation.load());
+        /* A thread going to sleep registers before checking
+         * generation, so either it sees the new generation or it is
+         * counted here */
+        if ( sleepers.load() != 0 ) {
+#ifdef __linux__
+            syscall(SYS_futex, &wakeWord, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#else
+            std::lock_guard<std::mutex> lock(sleepLock);
+            sleepCond.notify_all();
+#endif
+        }
+    }
+
+    void sleep(size_t gen)
+    {
+#ifdef __linux__
+        ++sleepers;
+        while ( gen == generation.load() ) {
+            /* Returns at once if wakeWord has already moved on */
+            syscall(SYS_futex, &wakeWord, FUTEX_WAIT_PRIVATE, (uint32_t)gen, NULL, NULL, 0);
+        }
+        --sleepers;
+#else
+        std::unique_lock<std::mutex> lock(sleepLock);
+        ++sleepers;
+        while ( gen == generation.load() ) {
+            sleepCond.wait(lock);
+        }
+        --sleepers;
+#endif
     }
 };
 
@@ -292,6 +526,110 @@ public:
 
 };
 
+/**
+ * Unbounded queue for exactly one producer thread and one consumer
+ * thread.  Neither side takes a lock or does a read-modify-write on
+ * the fast path, so the consumer can drain it while the producer is
+ * still inserting.  Items are stored in blocks; the last block the
+ * consumer finished with is kept for the producer to reuse.
+ */
+template<typename T>
+class SPSCQueue {
+    static const size_t BLOCK_SIZE = 256;
+
+    struct Block {
+        std::atomic<Block*> next;
+        T data[BLOCK_SIZE];
+
+        Block() : next(nullptr) { }
+    };
+
+    // Consumer side
+    CACHE_ALIGNED(Block*, head);
+    size_t headPos;
+    size_t rCount;
+    // Producer side
+    CACHE_ALIGNED(Block*, tail);
+    size_t tailPos;
+    size_t wCount;
+    // Shared
+    CACHE_ALIGNED(std::atomic<size_t>, written);
+    std::atomic<Block*> spare;
+
+public:
+    SPSCQueue() :
+        headPos(0), rCount(0), tailPos(0), wCount(0), written(0), spare(nullptr)
+    {
+        head = tail = new Block();
+    }
+
+    ~SPSCQueue() {
+        while ( head != nullptr ) {
+            Block* tmp = head;
+            head = tmp->next.load();
+            delete tmp;
+        }
+        delete spare.load();
+    }
+
+    /** Number of items in the queue.  Only exact on the consumer. */
+    size_t size() const
+    {
+        return written.load(std::memory_order_acquire) - rCount;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Producer only */
+    void insert(const T& t) {
+        if ( tailPos == BLOCK_SIZE ) {
+            Block* block = spare.exchange(nullptr, std::memory_order_acquire);
+            if ( block == nullptr ) block = new Block();
+            else block->next.store(nullptr, std::memory_order_relaxed);
+            tail->next.store(block, std::memory_order_release);
+            tail = block;
+            tailPos = 0;
+        }
+        tail->data[tailPos++] = t;
+        written.store(++wCount, std::memory_order_release);
+    }
+
+    /** Consumer only */
+    bool try_remove(T& result) {
+        if ( rCount == written.load(std::memory_order_acquire) ) return false;
+        result = next();
+        return true;
+    }
+
+    /** Consumer only.  Appends everything in the queue to vec and
+     * returns the number of items taken. */
+    size_t take(std::vector<T>& vec) {
+        size_t avail = written.load(std::memory_order_acquire) - rCount;
+        for ( size_t i = 0; i < avail; i++ ) {
+            vec.push_back(next());
+        }
+        return avail;
+    }
+
+private:
+    // Caller has checked that an item is available
+    T next() {
+        if ( headPos == BLOCK_SIZE ) {
+            // The producer linked the next block before publishing
+            // the item in it
+            Block* old = head;
+            head = old->next.load(std::memory_order_acquire);
+            headPos = 0;
+            delete spare.exchange(old, std::memory_order_acq_rel);
+        }
+        rCount++;
+        return head->data[headPos++];
+    }
+};
+
 }
 }
 }
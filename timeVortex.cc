@@ -14,10 +14,6 @@
 #include "sst/core/serialization.h"
 
 #include <sst/core/timeVortex.h>
-#include <sst/core/output.h>
-
-#include <sst/core/clock.h>
-#include <sst/core/simulation.h>
 
 namespace SST {
 
@@ -25,68 +21,76 @@ TimeVortex::TimeVortex() :
     ActivityQueue(),
     insertOrder(0),
     current_depth(0),
-    max_depth(0)
+    max_depth(0),
+    keep_order(false),
+    batch_open(false),
+    batch_conflict(false),
+    batch_time(0),
+    batch_priority(0)
 {}
 
 TimeVortex::~TimeVortex()
+{}
+
+void
+TimeVortex::popBatch(std::vector<Activity*>& batch)
 {
-    // Activities in TimeVortex all need to be deleted
-    while ( !data.empty() ) {
-        Activity *it = data.top();
-        delete it;
-        data.pop();
+    Activity* first = pop();
+    if ( first == NULL ) return;
+    batch.push_back(first);
+
+    SimTime_t time = first->getDeliveryTime();
+    int priority = first->getPriority();
+    while ( !empty() ) {
+        Activity* next = front();
+        if ( next->getDeliveryTime() != time || next->getPriority() != priority ) break;
+        batch.push_back(pop());
     }
-}
 
-bool TimeVortex::empty()
-{
-    return data.empty();
+    openBatch(time, priority);
 }
 
-int TimeVortex::size()
+void
+TimeVortex::returnBatch(std::vector<Activity*>& batch, size_t first)
 {
-    return data.size();
+    batch_open = false;
+    for ( size_t i = first; i < batch.size(); i++ ) {
+        insertOrdered(batch[i]);
+    }
+    batch.resize(first);
+    batch_open = true;
 }
 
-void TimeVortex::insert(Activity* activity)
+bool
+TimeVortex::addTimeVortex(const std::string name, const TimeVortex::timeVortexAlloc alloc, const std::string description)
 {
-    activity->setQueueOrder(insertOrder++);
-    data.push(activity);
-    current_depth++;
-    if ( current_depth > max_depth ) {
-        max_depth = current_depth;
-    }
+    timevortex_allocs()[name] = alloc;
+    timevortex_descriptions()[name] = description;
+    return true;
 }
 
-Activity* TimeVortex::pop()
+TimeVortex*
+TimeVortex::getTimeVortex(const std::string& name)
 {
-    if ( data.empty() ) return NULL;
-    Activity* ret_val = data.top();
-    data.pop();
-    current_depth--;
-    return ret_val;
-
+    if ( timevortex_allocs().find(name) == timevortex_allocs().end() ) return NULL;
+    timeVortexAlloc alloc = timevortex_allocs()[name];
+    return (*alloc)();
 }
 
-Activity* TimeVortex::front()
+std::map<std::string, TimeVortex::timeVortexAlloc>&
+TimeVortex::timevortex_allocs()
 {
-    return data.top();
+    static std::map<std::string, TimeVortex::timeVortexAlloc> cache;
+    return cache;
 }
 
-void TimeVortex::print(Output &out) const
+std::map<std::string, std::string>&
+TimeVortex::timevortex_descriptions()
 {
-    out.output("TimeVortex state:\n");
-
-//  STL's priority_queue does not support iteration.
-//
-//    dataType_t::iterator it;
-//    for ( it = data.begin(); it != data.end(); it++ ) {
-//        (*it)->print("  ", out);
-//    }
+    static std::map<std::string, std::string> cache;
+    return cache;
 }
 
-
-
 } // namespace SST
 
 BOOST_CLASS_EXPORT_IMPLEMENT(SST::ActivityQueue)
@@ -14,9 +14,9 @@
 
 #include <sst/core/serialization.h>
 
-#include <cstdio> // For printf
-#include <functional>
-#include <queue>
+#include <map>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <sst/core/activityQueue.h>
@@ -27,46 +27,160 @@ class Output;
 
 /**
  * Primary Event Queue
+ *
+ * Base class for the queue engines used as the main event queue of a
+ * Simulation.  Implementations must deliver Activities in (time,
+ * priority, link order, queue order) order and maintain the depth
+ * counters.  The engine used is selected at runtime by name (see
+ * getTimeVortex()).
  */
 class TimeVortex : public ActivityQueue {
 public:
-	TimeVortex();
-    ~TimeVortex();
 
-    bool empty();
-    int size();
-    void insert(Activity* activity);
-    Activity* pop();
-    Activity* front();
+    typedef TimeVortex* (*timeVortexAlloc)();
+private:
+    static std::map<std::string, TimeVortex::timeVortexAlloc>& timevortex_allocs();
+    static std::map<std::string, std::string>& timevortex_descriptions();
+
+public:
+    TimeVortex();
+    virtual ~TimeVortex();
+
+    static bool addTimeVortex(const std::string name, const TimeVortex::timeVortexAlloc alloc, const std::string description);
+    /** Create a TimeVortex of the requested type
+     * @param name - name of the queue engine
+     * @return new TimeVortex, or NULL if name is not known
+     */
+    static TimeVortex* getTimeVortex(const std::string& name);
+
+    static const std::map<std::string, std::string>& getDescriptionMap() { return timevortex_descriptions(); }
 
     /** Print the state of the TimeVortex */
-    void print(Output &out) const;
+    virtual void print(Output &out) const = 0;
 
     uint64_t getCurrentDepth() const { return current_depth; }
     uint64_t getMaxDepth() const { return max_depth; }
-    
-private:
-#ifdef SST_ENFORCE_EVENT_ORDERING
-    typedef std::priority_queue<Activity*, std::vector<Activity*>, Activity::pq_less_time_priority_order> dataType_t;
-#else
-    typedef std::priority_queue<Activity*, std::vector<Activity*>, Activity::pq_less_time_priority> dataType_t;
-#endif
-    dataType_t data;
+
+    /** Remove the next activity and every following activity with
+     * the same delivery time and priority, appending them to batch in
+     * delivery order.  The batch stays open until closeBatch() is
+     * called.
+     */
+    virtual void popBatch(std::vector<Activity*>& batch);
+
+    /** Returns true if an activity that has to be delivered before
+     * the rest of the open batch (an earlier time, or the same time and
+     * a priority value no higher than the batch's) was inserted since
+     * popBatch().  Any
+     * remaining batch entries must then be handed back with
+     * returnBatch() to keep the delivery order exact.
+     */
+    bool batchConflict() const { return batch_conflict; }
+
+    /** Put the unexecuted entries of the open batch (starting at
+     * index first) back into the queue.  Their original insertion
+     * order is kept. */
+    void returnBatch(std::vector<Activity*>& batch, size_t first);
+
+    /** Remove every Event delivered on one of links, appending them
+     * to events in delivery order.  The other activities keep their
+     * place in the queue.  Must not be called while a batch is open.
+     */
+    virtual void extractEvents(const std::unordered_set<Link*>& links, std::vector<Activity*>& events) = 0;
+
+    /** Close the batch opened by popBatch() */
+    void closeBatch() {
+        batch_open = false;
+        batch_conflict = false;
+    }
+
+    /** Give an activity the next queue order without inserting it.
+     * Used by queues that hold activities back from the TimeVortex
+     * and insert them later with insertOrdered(). */
+    void assignQueueOrder(Activity* activity) {
+        activity->setQueueOrder(insertOrder++);
+    }
+
+    /** Count an activity held back from the TimeVortex by a queue in
+     * front of it, so the depths include it */
+    void holdActivity() {
+        current_depth++;
+        if ( current_depth > max_depth ) {
+            max_depth = current_depth;
+        }
+    }
+
+    /** Stop counting a held back activity, before it is inserted */
+    void releaseActivity() {
+        current_depth--;
+    }
+
+    /** Insert an activity, keeping the queue order it already has */
+    void insertOrdered(Activity* activity) {
+        keep_order = true;
+        insert(activity);
+        keep_order = false;
+    }
+
+protected:
     uint64_t insertOrder;
 
     uint64_t current_depth;
     uint64_t max_depth;
-    
+
+    /** Must be called by implementations on every insert */
+    inline void recordInsert(Activity* activity) {
+        if ( UNLIKELY(batch_open) ) {
+            // e.g. the StopAction inserted by Exit at the current time
+            // from inside a batch of events
+            SimTime_t time = activity->getDeliveryTime();
+            if ( time < batch_time ||
+                 ( time == batch_time && activity->getPriority() <= batch_priority ) ) {
+                batch_conflict = true;
+            }
+        }
+        if ( LIKELY(!keep_order) ) {
+            activity->setQueueOrder(insertOrder++);
+        }
+        current_depth++;
+        if ( current_depth > max_depth ) {
+            max_depth = current_depth;
+        }
+    }
+
+    /** Must be called by implementations on every successful pop */
+    inline void recordPop() {
+        current_depth--;
+    }
+
+    /** True if activity is an Event delivered on one of links */
+    static bool deliveredOn(Activity* activity, const std::unordered_set<Link*>& links) {
+        Link* link = activity->getDeliveryLink();
+        return link != NULL && links.count(link) != 0;
+    }
+
+    /** Must be called by implementations of popBatch() once the batch
+     * has been extracted */
+    void openBatch(SimTime_t time, int priority) {
+        batch_time = time;
+        batch_priority = priority;
+        batch_conflict = false;
+        batch_open = true;
+    }
+
+private:
+    bool          keep_order;
+    bool          batch_open;
+    bool          batch_conflict;
+    SimTime_t     batch_time;
+    int           batch_priority;
+
     friend class boost::serialization::access;
     template<class Archive>
     void
     serialize(Archive & ar, const unsigned int version )
     {
-        printf("begin TimeVortex::serialize\n");
         ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ActivityQueue);
-        printf("  - TimeVortex::data\n");
-//        ar & BOOST_SERIALIZATION_NVP(data);
-        printf("end TimeVortex::serialize\n");
     }
 };
 
@@ -0,0 +1,350 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/timeVortexCalendar.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+
+namespace SST {
+
+bool TimeVortexCalendar::initialized = TimeVortex::addTimeVortex("calendar", &TimeVortexCalendar::allocate, "Calendar queue keyed on delivery time buckets.  O(1) average insert and pop; preferred for very large numbers of events in flight.");
+
+#ifdef SST_ENFORCE_EVENT_ORDERING
+typedef Activity::pq_less_time_priority_order compare_t;
+#else
+typedef Activity::pq_less_time_priority compare_t;
+#endif
+
+// Never shrink below this many buckets
+static const size_t MIN_BUCKETS = 16;
+// Number of activities sampled to compute a new bucket width
+static const size_t WIDTH_SAMPLES = 32;
+
+TimeVortexCalendar::TimeVortexCalendar() :
+    TimeVortex(),
+    nbuckets(MIN_BUCKETS),
+    bucket_mask(MIN_BUCKETS - 1),
+    bucket_shift(0),
+    count(0),
+    last_time(0),
+    next_valid(false),
+    next_bucket(0),
+    next_time(0)
+{
+    buckets.resize(nbuckets);
+}
+
+TimeVortexCalendar::~TimeVortexCalendar()
+{
+    // Activities in TimeVortex all need to be deleted
+    for ( size_t i = 0; i < buckets.size(); i++ ) {
+        for ( size_t j = 0; j < buckets[i].size(); j++ ) {
+            delete buckets[i][j];
+        }
+        buckets[i].clear();
+    }
+}
+
+bool TimeVortexCalendar::empty()
+{
+    return count == 0;
+}
+
+int TimeVortexCalendar::size()
+{
+    return count;
+}
+
+void TimeVortexCalendar::insert(Activity* activity)
+{
+    recordInsert(activity);
+
+    SimTime_t time = activity->getDeliveryTime();
+    size_t index = getBucket(time);
+    bucket_t& bucket = buckets[index];
+    bucket.push_back(activity);
+    std::push_heap(bucket.begin(), bucket.end(), compare_t());
+    count++;
+
+    // Activities are never scheduled in the past during the run, but
+    // keep the search start point correct if one is.
+    if ( time < last_time ) last_time = time;
+
+    // If the new activity is now the earliest, it lives in its own
+    // bucket, so we can just point the cache at it.
+    if ( next_valid && time < next_time ) {
+        next_bucket = index;
+        next_time = time;
+    }
+
+    if ( count > 2 * nbuckets ) resize(2 * nbuckets);
+}
+
+Activity* TimeVortexCalendar::pop()
+{
+    if ( count == 0 ) return NULL;
+    findNext();
+
+    bucket_t& bucket = buckets[next_bucket];
+    std::pop_heap(bucket.begin(), bucket.end(), compare_t());
+    Activity* ret_val = bucket.back();
+    bucket.pop_back();
+    count--;
+    recordPop();
+
+    last_time = next_time;
+    next_valid = false;
+
+    if ( nbuckets > MIN_BUCKETS && count < nbuckets / 2 ) resize(nbuckets / 2);
+    return ret_val;
+}
+
+void TimeVortexCalendar::popBatch(std::vector<Activity*>& batch)
+{
+    if ( count == 0 ) return;
+    findNext();
+
+    // As in the 4-ary heap, every activity with the same time and
+    // priority as the top of the bucket's heap is reachable from the
+    // top through activities with that same key, so the run is a
+    // subtree at the top of the heap.  (Heaps built by the standard
+    // heap algorithms keep the children of entry i at 2i+1 and 2i+2.)
+    bucket_t& bucket = buckets[next_bucket];
+    const SimTime_t time = next_time;
+    const int priority = bucket.front()->getPriority();
+    size_t size = bucket.size();
+    holes.clear();
+    holes.push_back(0);
+    for ( size_t h = 0; h < holes.size(); h++ ) {
+        size_t first = 2 * holes[h] + 1;
+        size_t last = std::min(first + 2, size);
+        for ( size_t c = first; c < last; c++ ) {
+            if ( bucket[c]->getDeliveryTime() == time && bucket[c]->getPriority() == priority ) {
+                holes.push_back(c);
+            }
+        }
+    }
+
+    if ( holes.size() == 1 ) {
+        batch.push_back(pop());
+        openBatch(time, priority);
+        return;
+    }
+
+    size_t start = batch.size();
+    for ( size_t h = 0; h < holes.size(); h++ ) {
+        batch.push_back(bucket[holes[h]]);
+        bucket[holes[h]] = NULL;
+        recordPop();
+    }
+    std::sort(batch.begin() + start, batch.end(), [](const Activity* lhs, const Activity* rhs) {
+            return compare_t()(rhs, lhs);
+        });
+
+    // Fill the holes inside the shrunk heap with the activities left
+    // past its end and restore the heap bottom up, one sift down per
+    // hole.  The holes were found level by level, so they are in index
+    // order.
+    size -= holes.size();
+    size_t tail = size;
+    for ( size_t h = holes.size(); h-- > 0; ) {
+        if ( holes[h] >= size ) continue;
+        while ( bucket[tail] == NULL ) tail++;
+        siftDown(bucket, holes[h], bucket[tail], size);
+        tail++;
+    }
+    bucket.resize(size);
+    count -= holes.size();
+
+    last_time = time;
+    next_valid = false;
+    openBatch(time, priority);
+
+    if ( nbuckets > MIN_BUCKETS && count < nbuckets / 2 ) resize(nbuckets / 2);
+}
+
+void TimeVortexCalendar::extractEvents(const std::unordered_set<Link*>& links, std::vector<Activity*>& events)
+{
+    size_t start = events.size();
+    for ( size_t i = 0; i < nbuckets; i++ ) {
+        bucket_t& bucket = buckets[i];
+        size_t kept = 0;
+        for ( size_t j = 0; j < bucket.size(); j++ ) {
+            if ( deliveredOn(bucket[j], links) ) {
+                events.push_back(bucket[j]);
+                recordPop();
+            }
+            else {
+                bucket[kept++] = bucket[j];
+            }
+        }
+        if ( kept == bucket.size() ) continue;
+        bucket.resize(kept);
+        std::make_heap(bucket.begin(), bucket.end(), compare_t());
+    }
+    if ( events.size() == start ) return;
+
+    count -= events.size() - start;
+    next_valid = false;
+    std::sort(events.begin() + start, events.end(), [](const Activity* lhs, const Activity* rhs) {
+            return compare_t()(rhs, lhs);
+        });
+
+    if ( nbuckets > MIN_BUCKETS && count < nbuckets / 2 ) resize(nbuckets / 2);
+}
+
+void TimeVortexCalendar::siftDown(bucket_t& bucket, size_t i, Activity* activity, size_t size)
+{
+    compare_t later;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if ( child >= size ) break;
+        if ( child + 1 < size && later(bucket[child], bucket[child + 1]) ) child++;
+        if ( !later(activity, bucket[child]) ) break;
+        bucket[i] = bucket[child];
+        i = child;
+    }
+    bucket[i] = activity;
+}
+
+Activity* TimeVortexCalendar::front()
+{
+    if ( count == 0 ) return NULL;
+    findNext();
+    return buckets[next_bucket].front();
+}
+
+void TimeVortexCalendar::findNext()
+{
+    if ( next_valid ) return;
+
+    // Walk forward one bucket ("day") at a time, starting with the
+    // day holding last_time.  The first bucket whose earliest
+    // activity falls within the current day holds the next activity.
+    // Because activities with equal delivery times always share a
+    // bucket, the heap order within the bucket gives the exact
+    // delivery order.
+    SimTime_t day = last_time >> bucket_shift;
+    size_t index = day & bucket_mask;
+    for ( size_t i = 0; i < nbuckets; i++ ) {
+        const bucket_t& bucket = buckets[index];
+        if ( !bucket.empty() ) {
+            SimTime_t time = bucket.front()->getDeliveryTime();
+            if ( (time >> bucket_shift) == day ) {
+                next_bucket = index;
+                next_time = time;
+                next_valid = true;
+                return;
+            }
+        }
+        day++;
+        index = (index + 1) & bucket_mask;
+    }
+
+    // Nothing within one full pass over the calendar (sparse
+    // queue), so search directly for the earliest activity.
+    bool found = false;
+    for ( size_t i = 0; i < nbuckets; i++ ) {
+        const bucket_t& bucket = buckets[i];
+        if ( bucket.empty() ) continue;
+        SimTime_t time = bucket.front()->getDeliveryTime();
+        if ( !found || time < next_time ) {
+            next_bucket = i;
+            next_time = time;
+            found = true;
+        }
+    }
+    next_valid = found;
+}
+
+void TimeVortexCalendar::resize(size_t new_nbuckets)
+{
+    std::vector<Activity*> all;
+    all.reserve(count);
+    for ( size_t i = 0; i < buckets.size(); i++ ) {
+        all.insert(all.end(), buckets[i].begin(), buckets[i].end());
+        buckets[i].clear();
+    }
+
+    // Compute a new bucket width from the average separation of the
+    // earliest activities, ignoring outliers (Brown, 1988).  The width
+    // is kept a power of two so bucket lookup is a shift and mask.
+    size_t nsamples = std::min(all.size(), WIDTH_SAMPLES);
+    if ( nsamples > 1 ) {
+        auto earlier = [](const Activity* lhs, const Activity* rhs) {
+            return lhs->getDeliveryTime() < rhs->getDeliveryTime();
+        };
+        std::nth_element(all.begin(), all.begin() + (nsamples - 1), all.end(), earlier);
+        std::sort(all.begin(), all.begin() + nsamples, earlier);
+
+        SimTime_t total = 0;
+        size_t ngaps = 0;
+        for ( size_t i = 1; i < nsamples; i++ ) {
+            SimTime_t gap = all[i]->getDeliveryTime() - all[i-1]->getDeliveryTime();
+            if ( gap == 0 ) continue;
+            total += gap;
+            ngaps++;
+        }
+
+        if ( ngaps > 0 ) {
+            SimTime_t avg = total / ngaps;
+            SimTime_t filtered = 0;
+            size_t nfiltered = 0;
+            for ( size_t i = 1; i < nsamples; i++ ) {
+                SimTime_t gap = all[i]->getDeliveryTime() - all[i-1]->getDeliveryTime();
+                if ( gap == 0 || gap > 2 * avg ) continue;
+                filtered += gap;
+                nfiltered++;
+            }
+            if ( nfiltered > 0 ) avg = filtered / nfiltered;
+
+            SimTime_t width = 3 * avg;
+            bucket_shift = 0;
+            while ( bucket_shift < 63 && ((SimTime_t)1 << bucket_shift) < width ) bucket_shift++;
+        }
+    }
+
+    nbuckets = new_nbuckets;
+    bucket_mask = nbuckets - 1;
+    buckets.resize(nbuckets);
+
+    for ( size_t i = 0; i < all.size(); i++ ) {
+        buckets[getBucket(all[i]->getDeliveryTime())].push_back(all[i]);
+    }
+    for ( size_t i = 0; i < nbuckets; i++ ) {
+        std::make_heap(buckets[i].begin(), buckets[i].end(), compare_t());
+    }
+
+    next_valid = false;
+}
+
+void TimeVortexCalendar::print(Output &out) const
+{
+    out.output("TimeVortex state (calendar, %zu buckets, width %" PRIu64 "):\n",
+               nbuckets, (SimTime_t)1 << bucket_shift);
+
+    // Activities are printed in bucket order, not delivery order
+    for ( size_t i = 0; i < buckets.size(); i++ ) {
+        for ( size_t j = 0; j < buckets[i].size(); j++ ) {
+            buckets[i][j]->print("  ", out);
+        }
+    }
+}
+
+
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::TimeVortexCalendar)
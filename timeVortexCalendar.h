@@ -0,0 +1,107 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_TIMEVORTEXCALENDAR_H
+#define SST_CORE_TIMEVORTEXCALENDAR_H
+
+#include <sst/core/serialization.h>
+
+#include <vector>
+
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+class Output;
+
+/**
+ * Primary Event Queue implemented as a calendar queue.
+ *
+ * Activities are hashed on delivery_time into an array of buckets
+ * ("days"), each a power of two core cycles wide.  Each bucket is a
+ * small heap ordered with the same comparator as the default
+ * TimeVortex, so all activities with the same delivery time share a
+ * bucket and are delivered in exactly the same order.  The number of
+ * buckets and the bucket width are recomputed as the queue grows and
+ * shrinks so that each bucket holds only a few activities, which
+ * makes insert and pop O(1) on average.
+ */
+class TimeVortexCalendar : public TimeVortex {
+public:
+    TimeVortexCalendar();
+    ~TimeVortexCalendar();
+
+    bool empty();
+    int size();
+    void insert(Activity* activity);
+    Activity* pop();
+    Activity* front();
+    void popBatch(std::vector<Activity*>& batch);
+    void extractEvents(const std::unordered_set<Link*>& links, std::vector<Activity*>& events);
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const;
+
+    static TimeVortex* allocate() {
+        return new TimeVortexCalendar();
+    }
+
+private:
+    typedef std::vector<Activity*> bucket_t;
+
+    /** Find the bucket holding the next activity and cache it */
+    void findNext();
+    /** Rebuild the calendar with a new number of buckets */
+    void resize(size_t new_nbuckets);
+    /** Place activity at index i of the bucket's heap of the given
+     * size, moving it down as needed */
+    void siftDown(bucket_t& bucket, size_t i, Activity* activity, size_t size);
+
+    inline size_t getBucket(SimTime_t time) const {
+        return (time >> bucket_shift) & bucket_mask;
+    }
+
+    std::vector<bucket_t> buckets;
+    size_t    nbuckets;
+    size_t    bucket_mask;
+    uint32_t  bucket_shift;  /* bucket width is 2^bucket_shift cycles */
+    size_t    count;
+
+    /* Delivery time of the last popped activity.  Nothing can be
+     * inserted before this time, so the search for the next activity
+     * starts here. */
+    SimTime_t last_time;
+
+    /* Cached location of the next activity.  Valid until the next
+     * pop(), or until an earlier activity is inserted. */
+    bool      next_valid;
+    size_t    next_bucket;
+    SimTime_t next_time;
+
+    /* Scratch space for popBatch(), kept to avoid reallocation */
+    std::vector<size_t> holes;
+
+    static bool initialized;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(TimeVortex);
+    }
+};
+
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::TimeVortexCalendar)
+
+#endif // SST_CORE_TIMEVORTEXCALENDAR_H
@@ -0,0 +1,238 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/timeVortexDHeap.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace SST {
+
+bool TimeVortexDHeap::initialized = TimeVortex::addTimeVortex("dheap", &TimeVortexDHeap::allocate, "Cache-aligned 4-ary heap storing the ordering key inline with each Activity pointer.  Never touches Activities while sifting.");
+
+TimeVortexDHeap::TimeVortexDHeap() :
+    TimeVortex(),
+    data(NULL),
+    count(0),
+    capacity(0)
+{
+    grow();
+}
+
+TimeVortexDHeap::~TimeVortexDHeap()
+{
+    // Activities in TimeVortex all need to be deleted
+    for ( size_t i = 0; i < count; i++ ) {
+        delete data[i + OFFSET].activity;
+    }
+    ::free(data);
+}
+
+bool TimeVortexDHeap::empty()
+{
+    return count == 0;
+}
+
+int TimeVortexDHeap::size()
+{
+    return count;
+}
+
+void TimeVortexDHeap::insert(Activity* activity)
+{
+    if ( count == capacity ) grow();
+
+    entry_t item;
+    item.time = activity->getDeliveryTime();
+    // Flip the sign bits so signed values order correctly as unsigned
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    item.order = ((uint64_t)((uint32_t)activity->getPriority() ^ 0x80000000u) << 32) |
+        ((uint32_t)activity->getEnforceLinkOrder() ^ 0x80000000u);
+#else
+    item.order = ((uint64_t)((uint32_t)activity->getPriority() ^ 0x80000000u) << 32);
+#endif
+    recordInsert(activity);
+    item.seq = activity->getQueueOrder();
+    item.activity = activity;
+
+    // Sift up
+    size_t i = count++;
+    while ( i > 0 ) {
+        size_t parent = (i - 1) / ARITY;
+        if ( !(item < data[parent + OFFSET]) ) break;
+        data[i + OFFSET] = data[parent + OFFSET];
+        i = parent;
+    }
+    data[i + OFFSET] = item;
+}
+
+Activity* TimeVortexDHeap::pop()
+{
+    if ( count == 0 ) return NULL;
+    Activity* ret_val = data[OFFSET].activity;
+    recordPop();
+
+    count--;
+    if ( count == 0 ) return ret_val;
+
+    // Sift the last entry down from the root
+    siftDown(0, data[count + OFFSET]);
+    return ret_val;
+}
+
+void TimeVortexDHeap::popBatch(std::vector<Activity*>& batch)
+{
+    if ( count == 0 ) return;
+
+    // Every entry with the same time and priority as the root is
+    // reachable from the root through entries with that same key
+    // (heap order), so the run is a subtree at the top of the heap.
+    const SimTime_t time = data[OFFSET].time;
+    const uint64_t priority = data[OFFSET].order >> 32;
+    holes.clear();
+    holes.push_back(0);
+    for ( size_t h = 0; h < holes.size(); h++ ) {
+        size_t first = ARITY * holes[h] + 1;
+        size_t last = std::min(first + ARITY, count);
+        for ( size_t c = first; c < last; c++ ) {
+            if ( data[c + OFFSET].time == time && (data[c + OFFSET].order >> 32) == priority ) {
+                holes.push_back(c);
+            }
+        }
+    }
+    if ( holes.size() == 1 ) {
+        Activity* activity = pop();
+        batch.push_back(activity);
+        openBatch(time, activity->getPriority());
+        return;
+    }
+
+    run.clear();
+    for ( size_t h = 0; h < holes.size(); h++ ) {
+        run.push_back(data[holes[h] + OFFSET]);
+        data[holes[h] + OFFSET].activity = NULL;
+    }
+    std::sort(run.begin(), run.end());
+    for ( size_t i = 0; i < run.size(); i++ ) {
+        batch.push_back(run[i].activity);
+        recordPop();
+    }
+
+    // Fill the holes inside the shrunk heap with the entries left past
+    // its end, then restore the heap bottom up (as in Floyd's
+    // heapify).  The subtrees below each hole are either untouched or
+    // holes already refilled, so one sift down per hole is enough.
+    // The holes were found level by level, so they are in index order.
+    count -= run.size();
+    size_t tail = count;
+    for ( size_t h = holes.size(); h-- > 0; ) {
+        if ( holes[h] >= count ) continue;
+        while ( data[tail + OFFSET].activity == NULL ) tail++;
+        siftDown(holes[h], data[tail + OFFSET]);
+        tail++;
+    }
+
+    openBatch(time, run[0].activity->getPriority());
+}
+
+void TimeVortexDHeap::extractEvents(const std::unordered_set<Link*>& links, std::vector<Activity*>& events)
+{
+    run.clear();
+    size_t kept = 0;
+    for ( size_t i = 0; i < count; i++ ) {
+        if ( deliveredOn(data[i + OFFSET].activity, links) ) {
+            run.push_back(data[i + OFFSET]);
+            recordPop();
+        }
+        else {
+            data[kept++ + OFFSET] = data[i + OFFSET];
+        }
+    }
+    if ( run.empty() ) return;
+
+    // Restore the heap bottom up (Floyd's heapify), starting at the
+    // parent of the last entry
+    count = kept;
+    if ( count > 1 ) {
+        for ( size_t i = (count - 2) / ARITY + 1; i-- > 0; ) {
+            siftDown(i, data[i + OFFSET]);
+        }
+    }
+
+    std::sort(run.begin(), run.end());
+    for ( size_t i = 0; i < run.size(); i++ ) {
+        events.push_back(run[i].activity);
+    }
+}
+
+void TimeVortexDHeap::siftDown(size_t i, const entry_t item)
+{
+    for (;;) {
+        size_t first = ARITY * i + 1;
+        if ( first >= count ) break;
+        size_t last = first + ARITY;
+        if ( last > count ) last = count;
+
+        size_t min = first;
+        for ( size_t c = first + 1; c < last; c++ ) {
+            if ( data[c + OFFSET] < data[min + OFFSET] ) min = c;
+        }
+        if ( !(data[min + OFFSET] < item) ) break;
+        data[i + OFFSET] = data[min + OFFSET];
+        i = min;
+    }
+    data[i + OFFSET] = item;
+}
+
+Activity* TimeVortexDHeap::front()
+{
+    if ( count == 0 ) return NULL;
+    return data[OFFSET].activity;
+}
+
+void TimeVortexDHeap::grow()
+{
+    size_t new_capacity = capacity ? 2 * capacity : 4096;
+    void* ptr = NULL;
+    // Two cache lines, so each group of four children is aligned
+    if ( posix_memalign(&ptr, 2 * 64, (new_capacity + OFFSET) * sizeof(entry_t)) ) {
+        throw std::bad_alloc();
+    }
+    entry_t* new_data = static_cast<entry_t*>(ptr);
+    if ( data != NULL ) {
+        std::memcpy(new_data + OFFSET, data + OFFSET, count * sizeof(entry_t));
+        ::free(data);
+    }
+    data = new_data;
+    capacity = new_capacity;
+}
+
+void TimeVortexDHeap::print(Output &out) const
+{
+    out.output("TimeVortex state (4-ary heap):\n");
+
+    // Activities are printed in heap order, not delivery order
+    for ( size_t i = 0; i < count; i++ ) {
+        data[i + OFFSET].activity->print("  ", out);
+    }
+}
+
+
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::TimeVortexDHeap)
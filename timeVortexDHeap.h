@@ -0,0 +1,102 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_TIMEVORTEXDHEAP_H
+#define SST_CORE_TIMEVORTEXDHEAP_H
+
+#include <sst/core/serialization.h>
+
+#include <vector>
+
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+class Output;
+
+/**
+ * Primary Event Queue implemented as a cache-aligned 4-ary heap.
+ *
+ * Each heap entry stores the ordering key next to the Activity
+ * pointer: a 128-bit (delivery time, priority and link order) key
+ * plus the insertion order used to break ties.  Sifting compares
+ * entries only and never dereferences the Activities.  Entries are 32
+ * bytes and the heap is laid out so that the four children of a node
+ * always fill exactly two aligned cache lines.
+ */
+class TimeVortexDHeap : public TimeVortex {
+public:
+    TimeVortexDHeap();
+    ~TimeVortexDHeap();
+
+    bool empty();
+    int size();
+    void insert(Activity* activity);
+    Activity* pop();
+    Activity* front();
+    void popBatch(std::vector<Activity*>& batch);
+    void extractEvents(const std::unordered_set<Link*>& links, std::vector<Activity*>& events);
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const;
+
+    static TimeVortex* allocate() {
+        return new TimeVortexDHeap();
+    }
+
+private:
+    struct entry_t {
+        SimTime_t time;
+        uint64_t  order;      /* priority (high word), link order (low word) */
+        uint64_t  seq;        /* insertion order */
+        Activity* activity;
+
+        inline bool operator<(const entry_t& rhs) const {
+            if ( time != rhs.time ) return time < rhs.time;
+            if ( order != rhs.order ) return order < rhs.order;
+            return seq < rhs.seq;
+        }
+    };
+
+    /* Logical entry i is stored at data[i + OFFSET], so the children
+     * of every node (logical 4i+1 .. 4i+4) start on a multiple of
+     * four entries. */
+    static const size_t ARITY = 4;
+    static const size_t OFFSET = ARITY - 1;
+
+    void grow();
+    /** Place item at logical index i, moving it down as needed */
+    void siftDown(size_t i, const entry_t item);
+
+    entry_t* data;
+    size_t   count;
+    size_t   capacity;
+
+    /* Scratch space for popBatch(), kept to avoid reallocation */
+    std::vector<entry_t> run;
+    std::vector<size_t>  holes;
+
+    static bool initialized;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(TimeVortex);
+    }
+};
+
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::TimeVortexDHeap)
+
+#endif // SST_CORE_TIMEVORTEXDHEAP_H
@@ -0,0 +1,110 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "sst/core/serialization.h"
+
+#include <sst/core/timeVortexPQ.h>
+#include <sst/core/output.h>
+
+#include <sst/core/clock.h>
+#include <sst/core/simulation.h>
+
+namespace SST {
+
+bool TimeVortexPQ::initialized = TimeVortex::addTimeVortex("pq", &TimeVortexPQ::allocate, "Binary heap (std::priority_queue) ordered on time, priority, link order and insertion order.  Default.");
+
+TimeVortexPQ::TimeVortexPQ() :
+    TimeVortex()
+{}
+
+TimeVortexPQ::~TimeVortexPQ()
+{
+    // Activities in TimeVortex all need to be deleted
+    while ( !data.empty() ) {
+        Activity *it = data.top();
+        delete it;
+        data.pop();
+    }
+}
+
+bool TimeVortexPQ::empty()
+{
+    return data.empty();
+}
+
+int TimeVortexPQ::size()
+{
+    return data.size();
+}
+
+void TimeVortexPQ::insert(Activity* activity)
+{
+    recordInsert(activity);
+    data.push(activity);
+}
+
+Activity* TimeVortexPQ::pop()
+{
+    if ( data.empty() ) return NULL;
+    Activity* ret_val = data.top();
+    data.pop();
+    recordPop();
+    return ret_val;
+
+}
+
+Activity* TimeVortexPQ::front()
+{
+    return data.top();
+}
+
+void TimeVortexPQ::extractEvents(const std::unordered_set<Link*>& links, std::vector<Activity*>& events)
+{
+    std::vector<Activity*>& heap = data.getHeap();
+    size_t start = events.size();
+    size_t kept = 0;
+    for ( size_t i = 0; i < heap.size(); i++ ) {
+        if ( deliveredOn(heap[i], links) ) {
+            events.push_back(heap[i]);
+            recordPop();
+        }
+        else {
+            heap[kept++] = heap[i];
+        }
+    }
+    if ( events.size() == start ) return;
+
+    heap.resize(kept);
+    data.rebuild();
+    std::sort(events.begin() + start, events.end(), [](const Activity* lhs, const Activity* rhs) {
+            return compare_t()(rhs, lhs);
+        });
+}
+
+void TimeVortexPQ::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+
+//  STL's priority_queue does not support iteration.
+//
+//    dataType_t::iterator it;
+//    for ( it = data.begin(); it != data.end(); it++ ) {
+//        (*it)->print("  ", out);
+//    }
+}
+
+
+
+} // namespace SST
+
+BOOST_CLASS_EXPORT_IMPLEMENT(SST::TimeVortexPQ)
@@ -0,0 +1,88 @@
+// Copyright 2009-2015 Sandia Corporation. Under the terms
+// of Contract DE-AC04-94AL85000 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2015, Sandia Corporation
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_TIMEVORTEXPQ_H
+#define SST_CORE_TIMEVORTEXPQ_H
+
+#include <sst/core/serialization.h>
+
+#include <algorithm>
+#include <cstdio> // For printf
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <sst/core/timeVortex.h>
+
+namespace SST {
+
+class Output;
+
+/**
+ * Primary Event Queue implemented as a binary heap
+ * (std::priority_queue).  This is the default TimeVortex.
+ */
+class TimeVortexPQ : public TimeVortex {
+public:
+    TimeVortexPQ();
+    ~TimeVortexPQ();
+
+    bool empty();
+    int size();
+    void insert(Activity* activity);
+    Activity* pop();
+    Activity* front();
+    void extractEvents(const std::unordered_set<Link*>& links, std::vector<Activity*>& events);
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const;
+
+    static TimeVortex* allocate() {
+        return new TimeVortexPQ();
+    }
+
+private:
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    typedef Activity::pq_less_time_priority_order compare_t;
+#else
+    typedef Activity::pq_less_time_priority compare_t;
+#endif
+    typedef std::priority_queue<Activity*, std::vector<Activity*>, compare_t> queue_t;
+
+    /* The priority_queue with access to its heap, so extractEvents()
+     * can take activities out of the middle */
+    class dataType_t : public queue_t {
+    public:
+        std::vector<Activity*>& getHeap() { return c; }
+        void rebuild() { std::make_heap(c.begin(), c.end(), comp); }
+    };
+    dataType_t data;
+
+    static bool initialized;
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void
+    serialize(Archive & ar, const unsigned int version )
+    {
+        printf("begin TimeVortexPQ::serialize\n");
+        ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(TimeVortex);
+        printf("  - TimeVortexPQ::data\n");
+//        ar & BOOST_SERIALIZATION_NVP(data);
+        printf("end TimeVortexPQ::serialize\n");
+    }
+};
+
+} //namespace SST
+
+BOOST_CLASS_EXPORT_KEY(SST::TimeVortexPQ)
+
+#endif // SST_CORE_TIMEVORTEXPQ_H